@@ -7,6 +7,8 @@
 
 #include "caramel-poly/Poly.hpp"
 
+#include <vector>
+
 
 namespace dyno_generic {
 
@@ -22,6 +24,17 @@ struct Iterator : decltype(caramel::poly::requires(
 	caramel::poly::EQUAL_LABEL = caramel::poly::function<bool (caramel::poly::SelfPlaceholder const&, caramel::poly::SelfPlaceholder const&)>
 )) { };
 
+} // end namespace dyno_generic
+
+template <typename Reference, typename It>
+auto const caramel::poly::defaultConceptMap<dyno_generic::Iterator<Reference>, It> = caramel::poly::makeConceptMap(
+	dyno_generic::increment_LABEL = [](It& self) { ++self; },
+	dyno_generic::dereference_LABEL = [](It& self) -> decltype(auto) { return *self; },
+	caramel::poly::EQUAL_LABEL = [](It const& a, It const& b) -> bool { return a == b; }
+);
+
+namespace dyno_generic {
+
 template <typename Value, typename StoragePolicy, typename VTablePolicy, typename Reference = Value&>
 struct any_iterator {
 	using value_type = Value;
@@ -29,11 +42,7 @@ struct any_iterator {
 
 	template <typename It>
 	explicit any_iterator(It it)
-		: poly_{std::move(it), caramel::poly::makeConceptMap(
-			increment_LABEL = [](It& self) { ++self; },
-			dereference_LABEL = [](It& self) -> decltype(auto) { return *self; },
-			caramel::poly::EQUAL_LABEL = [](It const& a, It const& b) -> bool { return a == b; }
-		)}
+		: poly_{std::move(it)}
 	{ }
 
 	any_iterator(any_iterator&& other)
@@ -78,6 +87,12 @@ using local_storage_inlined_vtable = dyno_generic::any_iterator<
 		caramel::poly::Remote<caramel::poly::EverythingElse>
 		>
 	>;
+
+using sealed = dyno_generic::any_iterator<
+	int,
+	caramel::poly::SealedStorage<std::vector<int>::iterator, int*>,
+	caramel::poly::VTable<caramel::poly::Sealed<std::vector<int>::iterator, int*>>
+	>;
 } // end namespace dyno_generic
 
 #endif // BENCHMARK_ANY_ITERATOR_DYNO_GENERIC_HPP
@@ -34,9 +34,21 @@ BENCHMARK_TEMPLATE(BM_copy, caramel::poly::SBOStorage<4>, WithSize<4>);
 BENCHMARK_TEMPLATE(BM_copy, caramel::poly::SBOStorage<8>, WithSize<4>);
 BENCHMARK_TEMPLATE(BM_copy, caramel::poly::SBOStorage<16>, WithSize<4>);
 BENCHMARK_TEMPLATE(BM_copy, caramel::poly::LocalStorage<16>, WithSize<4>);
+BENCHMARK_TEMPLATE(BM_copy, pooled_remote_storage, WithSize<4>);
+BENCHMARK_TEMPLATE(BM_copy, pooled_sbo_storage<4>, WithSize<4>);
+BENCHMARK_TEMPLATE(BM_copy, pooled_sbo_storage<8>, WithSize<4>);
+BENCHMARK_TEMPLATE(BM_copy, caramel::poly::SharedRemoteStorage<>, WithSize<4>);
+BENCHMARK_TEMPLATE(BM_copy, caramel::poly::IntrusiveSharedRemoteStorage<>, WithSize<4>);
+BENCHMARK_TEMPLATE(BM_copy, caramel::poly::IntrusiveSharedRemoteStorage<caramel::poly::NonAtomicRefCount>, WithSize<4>);
 
 BENCHMARK_TEMPLATE(BM_copy, caramel::poly::RemoteStorage<>, WithSize<16>);
 BENCHMARK_TEMPLATE(BM_copy, caramel::poly::SBOStorage<4>, WithSize<16>);
 BENCHMARK_TEMPLATE(BM_copy, caramel::poly::SBOStorage<8>, WithSize<16>);
 BENCHMARK_TEMPLATE(BM_copy, caramel::poly::SBOStorage<16>, WithSize<16>);
 BENCHMARK_TEMPLATE(BM_copy, caramel::poly::LocalStorage<16>, WithSize<16>);
+BENCHMARK_TEMPLATE(BM_copy, pooled_remote_storage, WithSize<16>);
+BENCHMARK_TEMPLATE(BM_copy, pooled_sbo_storage<4>, WithSize<16>);
+BENCHMARK_TEMPLATE(BM_copy, pooled_sbo_storage<8>, WithSize<16>);
+BENCHMARK_TEMPLATE(BM_copy, caramel::poly::SharedRemoteStorage<>, WithSize<16>);
+BENCHMARK_TEMPLATE(BM_copy, caramel::poly::IntrusiveSharedRemoteStorage<>, WithSize<16>);
+BENCHMARK_TEMPLATE(BM_copy, caramel::poly::IntrusiveSharedRemoteStorage<caramel::poly::NonAtomicRefCount>, WithSize<16>);
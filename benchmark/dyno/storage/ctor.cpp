@@ -35,6 +35,9 @@ BENCHMARK_TEMPLATE(BM_ctor, caramel::poly::SBOStorage<4>,    WithSize<4>);
 BENCHMARK_TEMPLATE(BM_ctor, caramel::poly::SBOStorage<8>,    WithSize<4>);
 BENCHMARK_TEMPLATE(BM_ctor, caramel::poly::SBOStorage<16>,   WithSize<4>);
 BENCHMARK_TEMPLATE(BM_ctor, caramel::poly::LocalStorage<16>, WithSize<4>);
+BENCHMARK_TEMPLATE(BM_ctor, pooled_remote_storage,           WithSize<4>);
+BENCHMARK_TEMPLATE(BM_ctor, pooled_sbo_storage<4>,           WithSize<4>);
+BENCHMARK_TEMPLATE(BM_ctor, pooled_sbo_storage<8>,           WithSize<4>);
 
 BENCHMARK_TEMPLATE(BM_ctor, inheritance_tag,         WithSize<16>);
 BENCHMARK_TEMPLATE(BM_ctor, caramel::poly::RemoteStorage<>,  WithSize<16>);
@@ -42,3 +45,6 @@ BENCHMARK_TEMPLATE(BM_ctor, caramel::poly::SBOStorage<4>,    WithSize<16>);
 BENCHMARK_TEMPLATE(BM_ctor, caramel::poly::SBOStorage<8>,    WithSize<16>);
 BENCHMARK_TEMPLATE(BM_ctor, caramel::poly::SBOStorage<16>,   WithSize<16>);
 BENCHMARK_TEMPLATE(BM_ctor, caramel::poly::LocalStorage<16>, WithSize<16>);
+BENCHMARK_TEMPLATE(BM_ctor, pooled_remote_storage,           WithSize<16>);
+BENCHMARK_TEMPLATE(BM_ctor, pooled_sbo_storage<4>,           WithSize<16>);
+BENCHMARK_TEMPLATE(BM_ctor, pooled_sbo_storage<8>,           WithSize<16>);
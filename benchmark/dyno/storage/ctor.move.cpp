@@ -36,6 +36,9 @@ BENCHMARK_TEMPLATE(BM_move, caramel::poly::SBOStorage<4>,    WithSize<4>);
 BENCHMARK_TEMPLATE(BM_move, caramel::poly::SBOStorage<8>,    WithSize<4>);
 BENCHMARK_TEMPLATE(BM_move, caramel::poly::SBOStorage<16>,   WithSize<4>);
 BENCHMARK_TEMPLATE(BM_move, caramel::poly::LocalStorage<16>, WithSize<4>);
+BENCHMARK_TEMPLATE(BM_move, pooled_remote_storage,           WithSize<4>);
+BENCHMARK_TEMPLATE(BM_move, pooled_sbo_storage<4>,           WithSize<4>);
+BENCHMARK_TEMPLATE(BM_move, pooled_sbo_storage<8>,           WithSize<4>);
 
 BENCHMARK_TEMPLATE(BM_move, inheritance_tag,         WithSize<16>);
 BENCHMARK_TEMPLATE(BM_move, caramel::poly::RemoteStorage<>,  WithSize<16>);
@@ -43,3 +46,6 @@ BENCHMARK_TEMPLATE(BM_move, caramel::poly::SBOStorage<4>,    WithSize<16>);
 BENCHMARK_TEMPLATE(BM_move, caramel::poly::SBOStorage<8>,    WithSize<16>);
 BENCHMARK_TEMPLATE(BM_move, caramel::poly::SBOStorage<16>,   WithSize<16>);
 BENCHMARK_TEMPLATE(BM_move, caramel::poly::LocalStorage<16>, WithSize<16>);
+BENCHMARK_TEMPLATE(BM_move, pooled_remote_storage,           WithSize<16>);
+BENCHMARK_TEMPLATE(BM_move, pooled_sbo_storage<4>,           WithSize<16>);
+BENCHMARK_TEMPLATE(BM_move, pooled_sbo_storage<8>,           WithSize<16>);
@@ -0,0 +1,119 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "caramel-poly/Poly.hpp"
+#include "caramel-poly/PolyCollection.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+// This benchmark measures the cost of updating particles of a few different
+// types. With `caramel::poly::method`, every particle is updated through its
+// own call to the vtable. With `caramel::poly::batchMethod`, a
+// `caramel::poly::PolyCollection` updates each type's particles with a single
+// call, either to a loop generated around the scalar update, or to a kernel
+// written for the whole array.
+
+constexpr auto update_LABEL = POLY_FUNCTION_LABEL("update");
+
+struct ScalarParticle : decltype(caramel::poly::requires(
+	caramel::poly::MoveConstructible{},
+	update_LABEL = caramel::poly::method<void (float)>
+)) { };
+
+struct BatchParticle : decltype(caramel::poly::requires(
+	caramel::poly::MoveConstructible{},
+	update_LABEL = caramel::poly::batchMethod<void (float)>
+)) { };
+
+struct BatchKernelParticle : decltype(caramel::poly::requires(
+	caramel::poly::MoveConstructible{},
+	update_LABEL = caramel::poly::batchMethod<void (float)>
+)) { };
+
+template <int Type>
+struct Particle {
+	float x = 0.0f;
+	float y = 0.0f;
+	float vx = 1.0f;
+	float vy = static_cast<float>(Type);
+
+	void update(float dt) {
+		x += vx * dt;
+		y += vy * dt;
+	}
+};
+
+template <typename T>
+auto const caramel::poly::defaultConceptMap<ScalarParticle, T> = caramel::poly::makeConceptMap(
+	update_LABEL = [](T& self, float dt) { self.update(dt); }
+);
+
+template <typename T>
+auto const caramel::poly::defaultConceptMap<BatchParticle, T> = caramel::poly::makeConceptMap(
+	update_LABEL = [](T& self, float dt) { self.update(dt); }
+);
+
+template <typename T>
+auto const caramel::poly::defaultConceptMap<BatchKernelParticle, T> = caramel::poly::makeConceptMap(
+	update_LABEL = [](T* particles, std::size_t count, float dt) {
+		for (std::size_t i = 0; i != count; ++i) {
+			particles[i].x += particles[i].vx * dt;
+			particles[i].y += particles[i].vy * dt;
+		}
+	}
+);
+
+template <typename Container>
+void add_particles(Container& container, int count) {
+	for (int i = 0; i != count; ++i) {
+		switch (i % 4) {
+		case 0: container.emplace_back(Particle<0>{}); break;
+		case 1: container.emplace_back(Particle<1>{}); break;
+		case 2: container.emplace_back(Particle<2>{}); break;
+		default: container.emplace_back(Particle<3>{}); break;
+		}
+	}
+}
+
+template <typename Concept>
+struct collection : caramel::poly::PolyCollection<Concept> {
+	template <typename T>
+	void emplace_back(T t) {
+		this->insert(std::move(t));
+	}
+};
+
+static void BM_update_vector(benchmark::State& state) {
+	std::vector<caramel::poly::Poly<ScalarParticle>> particles;
+	add_particles(particles, static_cast<int>(state.range(0)));
+	while (state.KeepRunning()) {
+		for (auto& particle : particles) {
+			particle.invoke(update_LABEL, 0.1f);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Concept>
+static void BM_update_collection(benchmark::State& state) {
+	collection<Concept> particles;
+	add_particles(particles, static_cast<int>(state.range(0)));
+	while (state.KeepRunning()) {
+		particles.invoke(update_LABEL, 0.1f);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static constexpr int N = 1 << 14;
+
+BENCHMARK(BM_update_vector)->Arg(N);
+BENCHMARK_TEMPLATE(BM_update_collection, ScalarParticle)->Arg(N);
+BENCHMARK_TEMPLATE(BM_update_collection, BatchParticle)->Arg(N);
+BENCHMARK_TEMPLATE(BM_update_collection, BatchKernelParticle)->Arg(N);
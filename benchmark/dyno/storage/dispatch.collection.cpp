@@ -0,0 +1,130 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "model.hpp"
+
+#include "caramel-poly/batch.hpp"
+#include "caramel-poly/Poly.hpp"
+#include "caramel-poly/PolyCollection.hpp"
+#include "caramel-poly/PolySequence.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+// This benchmark measures the cost of calling a method on every element of
+// a container holding objects of `TypeCount` different types, in random order.
+// `std::vector<Poly>` dispatches every call separately and follows a pointer
+// to every element, `caramel::poly::invokeAll` sorts the elements of the
+// vector by type before dispatching, `caramel::poly::PolySequence` dispatches every call
+// separately but walks a single buffer, and `caramel::poly::PolyCollection`
+// groups the elements by type and calls the same function on the whole group.
+
+template <std::size_t I>
+struct Element {
+	std::size_t value = I;
+};
+
+template <typename Container, std::size_t I>
+void insert(Container& container) {
+	if constexpr (std::is_same_v<Container, caramel::poly::PolyCollection<Concept>>) {
+		container.insert(Element<I>{});
+	} else if constexpr (std::is_same_v<Container, caramel::poly::PolySequence<Concept>>) {
+		container.pushBack(Element<I>{});
+	} else {
+		container.emplace_back(Element<I>{});
+	}
+}
+
+template <typename Container, std::size_t... I>
+constexpr auto makeInserters(std::index_sequence<I...>) {
+	return std::array<void (*)(Container&), sizeof...(I)>{ &insert<Container, I>... };
+}
+
+template <typename Container, std::size_t TypeCount>
+Container makeContainer(int size) {
+	constexpr auto inserters = makeInserters<Container>(std::make_index_sequence<TypeCount>{});
+	auto random = std::mt19937{};
+	auto types = std::uniform_int_distribution<std::size_t>{ 0, TypeCount - 1 };
+
+	auto container = Container{};
+	for (int i = 0; i != size; ++i) {
+		inserters[types(random)](container);
+	}
+	return container;
+}
+
+template <std::size_t TypeCount>
+static void BM_dispatch_collection_vector(benchmark::State& state) {
+	auto polys = makeContainer<std::vector<caramel::poly::Poly<Concept>>, TypeCount>(state.range(0));
+	while (state.KeepRunning()) {
+		for (auto& poly : polys) {
+			poly.virtual_(f1_LABEL)(poly);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <std::size_t TypeCount>
+static void BM_dispatch_collection_batched(benchmark::State& state) {
+	auto polys = makeContainer<std::vector<caramel::poly::Poly<Concept>>, TypeCount>(state.range(0));
+	while (state.KeepRunning()) {
+		caramel::poly::invokeAll(polys, f1_LABEL);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <std::size_t TypeCount>
+static void BM_dispatch_collection_sequence(benchmark::State& state) {
+	auto sequence = makeContainer<caramel::poly::PolySequence<Concept>, TypeCount>(state.range(0));
+	while (state.KeepRunning()) {
+		sequence.invoke(f1_LABEL);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <std::size_t TypeCount>
+static void BM_dispatch_collection_segmented(benchmark::State& state) {
+	auto collection = makeContainer<caramel::poly::PolyCollection<Concept>, TypeCount>(state.range(0));
+	while (state.KeepRunning()) {
+		collection.invoke(f1_LABEL);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Building the containers: `std::vector<Poly>` allocates every element
+// separately, while the other two only allocate when they grow.
+template <typename Container, std::size_t TypeCount>
+static void BM_build_collection(benchmark::State& state) {
+	while (state.KeepRunning()) {
+		auto container = makeContainer<Container, TypeCount>(state.range(0));
+		benchmark::DoNotOptimize(container);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static constexpr int N = 1 << 14;
+static constexpr int N_LARGE = 1 << 20;
+
+BENCHMARK_TEMPLATE(BM_dispatch_collection_vector, 2)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_batched, 2)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_sequence, 2)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_segmented, 2)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_vector, 8)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_batched, 8)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_sequence, 8)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_segmented, 8)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_vector, 64)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_batched, 64)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_sequence, 64)->Arg(N)->Arg(N_LARGE);
+BENCHMARK_TEMPLATE(BM_dispatch_collection_segmented, 64)->Arg(N)->Arg(N_LARGE);
+
+BENCHMARK_TEMPLATE(BM_build_collection, std::vector<caramel::poly::Poly<Concept>>, 8)->Arg(N);
+BENCHMARK_TEMPLATE(BM_build_collection, caramel::poly::PolySequence<Concept>, 8)->Arg(N);
+BENCHMARK_TEMPLATE(BM_build_collection, caramel::poly::PolyCollection<Concept>, 8)->Arg(N);
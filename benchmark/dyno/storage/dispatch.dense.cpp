@@ -0,0 +1,60 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "model.hpp"
+
+#include "caramel-poly/Poly.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+// This benchmark measures how the size of the storage policy affects dispatching
+// methods over a vector of type-erased wrappers too large to fit in the L1 cache.
+// The `sizeof` counter is the size of a single wrapper, `per_cache_line` is the
+// number of wrappers fitting in a 64-byte cache line.
+
+template <typename StoragePolicy, typename FirstHalf, typename SecondHalf>
+static void BM_dispatch_dense(benchmark::State& state) {
+	std::vector<model<StoragePolicy>> models;
+	models.reserve(state.range(0));
+	for (int i = 0; i != state.range(0); ++i) {
+		if (i % 2 == 0) {
+			models.push_back(model<StoragePolicy>{FirstHalf{}});
+		} else {
+			models.push_back(model<StoragePolicy>{SecondHalf{}});
+		}
+	}
+	benchmark::DoNotOptimize(models);
+	while (state.KeepRunning()) {
+		for (auto& model : models) {
+			model.f1();
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["sizeof"] = sizeof(model<StoragePolicy>);
+	state.counters["per_cache_line"] = 64.0 / sizeof(model<StoragePolicy>);
+}
+
+// Pointer-aligned rather than `std::aligned_storage_t<Bytes>`, which is usually
+// aligned to 16 bytes and would spill out of pointer-aligned buffers.
+template <std::size_t Bytes>
+using WithSize = std::aligned_storage_t<Bytes, alignof(void*)>;
+
+template <std::size_t Size>
+using pointer_aligned_sbo_storage = caramel::poly::SBOStorage<Size, alignof(void*)>;
+
+static constexpr int N = 1 << 16;
+
+BENCHMARK_TEMPLATE(BM_dispatch_dense, inheritance_tag,                        WithSize<8>, WithSize<16>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_dense, caramel::poly::RemoteStorage<>,         WithSize<8>, WithSize<16>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_dense, caramel::poly::SBOStorage<16>,          WithSize<8>, WithSize<16>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_dense, pointer_aligned_sbo_storage<16>,        WithSize<8>, WithSize<16>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_dense, caramel::poly::CompactSBOStorage<16>,   WithSize<8>, WithSize<16>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_dense, caramel::poly::CompactSBOStorage<24>,   WithSize<8>, WithSize<16>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_dense, caramel::poly::LocalStorage<16>,        WithSize<8>, WithSize<16>)->Arg(N);
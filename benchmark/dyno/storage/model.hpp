@@ -6,7 +6,9 @@
 #define BENCHMARK_STORAGE_MODEL_HPP
 
 #include "caramel-poly/Poly.hpp"
+#include "caramel-poly/PoolAllocator.hpp"
 #include <benchmark/benchmark.h>
+#include <cstddef>
 #include <memory>
 #include <utility>
 
@@ -32,6 +34,13 @@ auto const caramel::poly::defaultConceptMap<Concept, T> = caramel::poly::makeCon
 	f3_LABEL = [](T& self) { benchmark::DoNotOptimize(self); }
 );
 
+// Storage policies spilling to the heap through the pool allocator instead of malloc.
+using pooled_remote_storage = caramel::poly::RemoteStorage<caramel::poly::PoolAllocator<>>;
+
+template <std::size_t Size>
+using pooled_sbo_storage = caramel::poly::SBOStorage<
+	Size, static_cast<std::size_t>(-1), caramel::poly::PoolAllocator<>>;
+
 template <typename StoragePolicy>
 struct model {
 	template <typename T>
@@ -0,0 +1,55 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "model.hpp"
+
+#include "caramel-poly/Poly.hpp"
+#include "caramel-poly/RelocatingVector.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+
+// This benchmark measures the cost of growing a vector of type-erased wrappers
+// one element at a time, without reserving. `std::vector` moves the elements
+// to the new buffer only if the move constructor is noexcept and copies them
+// otherwise. `caramel::poly::RelocatingVector` does the same, except that it
+// uses a single memcpy for trivially relocatable Polys.
+
+template <typename StoragePolicy>
+using poly = caramel::poly::Poly<Concept, StoragePolicy>;
+
+using shared_storage = caramel::poly::IntrusiveSharedRemoteStorage<caramel::poly::NonAtomicRefCount>;
+using sbo_storage = caramel::poly::SBOStorage<16>;
+
+template <typename Vector>
+void push_back(Vector& v, const typename Vector::value_type& value) {
+	if constexpr (std::is_same_v<Vector, caramel::poly::RelocatingVector<typename Vector::value_type>>) {
+		v.pushBack(value);
+	} else {
+		v.push_back(value);
+	}
+}
+
+template <typename Vector>
+static void BM_vector_growth(benchmark::State& state) {
+	const typename Vector::value_type prototype{std::aligned_storage_t<8>{}};
+	while (state.KeepRunning()) {
+		Vector v;
+		for (int i = 0; i != state.range(0); ++i) {
+			push_back(v, prototype);
+		}
+		benchmark::DoNotOptimize(v.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static constexpr int N = 1 << 20;
+
+BENCHMARK_TEMPLATE(BM_vector_growth, std::vector<poly<shared_storage>>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_vector_growth, caramel::poly::RelocatingVector<poly<shared_storage>>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_vector_growth, std::vector<poly<sbo_storage>>)->Arg(N);
+BENCHMARK_TEMPLATE(BM_vector_growth, caramel::poly::RelocatingVector<poly<sbo_storage>>)->Arg(N);
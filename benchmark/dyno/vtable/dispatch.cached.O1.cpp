@@ -0,0 +1,25 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "dispatch.cached.hpp"
+
+// The `dispatch.cached` benchmark, built with `-O1` (see premake5.lua), where
+// the lookup in a remote vtable is not fully inlined, as in debug builds.
+
+namespace {
+
+struct ConceptO1 : decltype(caramel::poly::requires(Concept{})) { };
+
+} // namespace
+
+template <typename Call, typename ...Types>
+static void BM_dispatch_cached_O1(benchmark::State& state) {
+	run_dispatch_cached<ConceptO1, Call, Types...>(state);
+}
+
+static constexpr int N = 256;
+
+BENCHMARK_TEMPLATE(BM_dispatch_cached_O1, uncached, unsigned int)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_cached_O1, cached, unsigned int)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_cached_O1, uncached, unsigned int, unsigned long long)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_cached_O1, cached, unsigned int, unsigned long long)->Arg(N);
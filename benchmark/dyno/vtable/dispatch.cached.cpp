@@ -0,0 +1,20 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "dispatch.cached.hpp"
+
+// This benchmark measures the cost of calling functions from remote vtables
+// through a `CallSiteCache`, for runs of objects of the same type (where the
+// cache always hits) and for alternating types (where it always misses).
+
+template <typename Call, typename ...Types>
+static void BM_dispatch_cached(benchmark::State& state) {
+	run_dispatch_cached<Concept, Call, Types...>(state);
+}
+
+static constexpr int N = 256;
+
+BENCHMARK_TEMPLATE(BM_dispatch_cached, uncached, unsigned int)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_cached, cached, unsigned int)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_cached, uncached, unsigned int, unsigned long long)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_cached, cached, unsigned int, unsigned long long)->Arg(N);
@@ -0,0 +1,67 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef BENCHMARK_VTABLE_DISPATCH_CACHED_HPP
+#define BENCHMARK_VTABLE_DISPATCH_CACHED_HPP
+
+#include "model.hpp"
+
+#include "caramel-poly/CallSiteCache.hpp"
+#include "caramel-poly/Poly.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+// The calls measured by the `dispatch.cached` benchmarks, on polys of the given
+// concept. Each translation unit built with different options should use its
+// own concept, so that the linker doesn't pick the instantiations of another.
+
+template <typename ConceptT>
+using cached_poly = caramel::poly::Poly<
+	ConceptT,
+	caramel::poly::LocalStorage<8>,
+	caramel::poly::VTable<
+		caramel::poly::Local<caramel::poly::Only<decltype(f1_LABEL)>>,
+		caramel::poly::Remote<caramel::poly::EverythingElse>
+	>
+>;
+
+template <typename Poly, typename ...Types>
+std::vector<Poly> make_cached_polys(std::size_t size) {
+	std::vector<Poly> polys;
+	polys.reserve(size);
+	while (polys.size() != size) {
+		(polys.emplace_back(Types{}), ...);
+	}
+	return polys;
+}
+
+struct uncached {
+	template <typename Poly>
+	static void invoke(Poly& p) {
+		p.invoke(f2_LABEL, p);
+	}
+};
+
+struct cached {
+	template <typename Poly>
+	static void invoke(Poly& p) {
+		POLY_CACHED_INVOKE(f2_LABEL, p, p);
+	}
+};
+
+template <typename ConceptT, typename Call, typename ...Types>
+void run_dispatch_cached(benchmark::State& state) {
+	using Poly = cached_poly<ConceptT>;
+	auto polys = make_cached_polys<Poly, Types...>(static_cast<std::size_t>(state.range(0)));
+	while (state.KeepRunning()) {
+		for (auto& p : polys) {
+			Call::invoke(p);
+		}
+		benchmark::ClobberMemory();
+	}
+}
+
+#endif // BENCHMARK_VTABLE_DISPATCH_CACHED_HPP
@@ -0,0 +1,110 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "caramel-poly/DoubleDispatch.hpp"
+#include "caramel-poly/Poly.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <typeinfo>
+#include <vector>
+
+// This benchmark compares calling functions picked by the types of two
+// objects through a `DoubleDispatch` table and through nested `typeid`
+// comparisons, for all the pairs of four types.
+
+struct Shape : decltype(caramel::poly::requires(
+	caramel::poly::CopyConstructible{},
+	caramel::poly::TypeId{}
+)) { };
+
+template <int N>
+struct shape {
+	int value;
+};
+
+using poly = caramel::poly::Poly<
+	Shape,
+	caramel::poly::LocalStorage<8>,
+	caramel::poly::VTable<caramel::poly::Indexed<caramel::poly::Everything>>
+>;
+
+using signature = int (const caramel::poly::SelfPlaceholder&, const caramel::poly::SelfPlaceholder&);
+
+template <int A, int B>
+int collide(const shape<A>& a, const shape<B>& b) {
+	return a.value * (B + 1) + b.value;
+}
+
+template <int A, int... B>
+void define_row(caramel::poly::DoubleDispatch<signature, poly>& table, std::integer_sequence<int, B...>) {
+	(table.template define<shape<A>, shape<B>>([](const shape<A>& a, const shape<B>& b) { return collide(a, b); }), ...);
+}
+
+template <int... A>
+caramel::poly::DoubleDispatch<signature, poly> make_table(std::integer_sequence<int, A...> types) {
+	caramel::poly::DoubleDispatch<signature, poly> table;
+	(define_row<A>(table, types), ...);
+	return table;
+}
+
+template <int A, int B, int... Rest>
+int typeid_column(const shape<A>& a, const poly& b, const std::type_info& type) {
+	if (type == typeid(shape<B>)) {
+		return collide(a, *b.unsafeGet<shape<B>>());
+	} else if constexpr (sizeof...(Rest) != 0) {
+		return typeid_column<A, Rest...>(a, b, type);
+	} else {
+		return 0;
+	}
+}
+
+template <int A, int... Rest>
+int typeid_row(const poly& a, const poly& b, const std::type_info& type) {
+	if (type == typeid(shape<A>)) {
+		return typeid_column<A, 0, 1, 2, 3>(*a.unsafeGet<shape<A>>(), b, b.invoke(caramel::poly::TYPEID_LABEL));
+	} else if constexpr (sizeof...(Rest) != 0) {
+		return typeid_row<Rest...>(a, b, type);
+	} else {
+		return 0;
+	}
+}
+
+struct typeid_chain {
+	int operator()(const poly& a, const poly& b) const {
+		return typeid_row<0, 1, 2, 3>(a, b, a.invoke(caramel::poly::TYPEID_LABEL));
+	}
+};
+
+struct table {
+	caramel::poly::DoubleDispatch<signature, poly> dispatch = make_table(std::make_integer_sequence<int, 4>());
+
+	int operator()(const poly& a, const poly& b) const {
+		return caramel::poly::dispatch2(dispatch, a, b);
+	}
+};
+
+template <typename Dispatch>
+static void BM_dispatch_double(benchmark::State& state) {
+	std::vector<poly> polys;
+	polys.reserve(static_cast<std::size_t>(state.range(0)));
+	while (polys.size() != polys.capacity()) {
+		polys.emplace_back(shape<0>{ 1 });
+		polys.emplace_back(shape<2>{ 2 });
+		polys.emplace_back(shape<1>{ 3 });
+		polys.emplace_back(shape<3>{ 4 });
+	}
+
+	const auto dispatch = Dispatch{};
+	while (state.KeepRunning()) {
+		auto sum = 0;
+		for (std::size_t i = 1; i != polys.size(); ++i) {
+			sum += dispatch(polys[i - 1], polys[(i * 7) % polys.size()]);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_dispatch_double, typeid_chain)->Arg(256);
+BENCHMARK_TEMPLATE(BM_dispatch_double, table)->Arg(256);
@@ -0,0 +1,51 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "model.hpp"
+
+#include "caramel-poly/Poly.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// This benchmark compares dispatching calls on arrays of polys with a remote
+// vtable, which takes a pointer, with an indexed vtable, which takes a 32-bit
+// index, and with a sealed vtable, which takes a 1-byte tag. All store
+// objects of up to 12 bytes locally, so the polys take 24, 16 and 16 bytes
+// respectively.
+
+template <typename VTablePolicy>
+using poly = caramel::poly::Poly<Concept, caramel::poly::LocalStorage<12, 4>, VTablePolicy>;
+
+using remote = caramel::poly::VTable<caramel::poly::Remote<caramel::poly::Everything>>;
+using indexed = caramel::poly::VTable<caramel::poly::Indexed<caramel::poly::Everything, std::uint32_t>>;
+
+static_assert(sizeof(poly<remote>) == 24);
+static_assert(sizeof(poly<indexed>) == 16);
+static_assert(sizeof(poly<sealed>) == 16);
+
+template <typename VTablePolicy>
+static void BM_dispatch_indexed(benchmark::State& state) {
+	std::vector<poly<VTablePolicy>> polys;
+	polys.reserve(static_cast<std::size_t>(state.range(0)));
+	while (polys.size() != polys.capacity()) {
+		polys.emplace_back(static_cast<unsigned int>(polys.size()));
+		polys.emplace_back(static_cast<unsigned short>(polys.size()));
+		polys.emplace_back(static_cast<float>(polys.size()));
+		polys.emplace_back(static_cast<unsigned int>(polys.size()));
+	}
+
+	while (state.KeepRunning()) {
+		for (auto& p : polys) {
+			p.invoke(f1_LABEL, p);
+		}
+		benchmark::ClobberMemory();
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_dispatch_indexed, remote)->Arg(256)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_dispatch_indexed, indexed)->Arg(256)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_dispatch_indexed, sealed)->Arg(256)->Arg(1 << 20);
@@ -0,0 +1,83 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "model.hpp"
+
+#include "caramel-poly/Poly.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+// This benchmark measures the gain of speculatively devirtualizing calls with
+// `invokeLikely`, for call sites that see a single type (monomorphic), two
+// types (bimorphic), and types that aren't in the list of likely ones.
+
+template <typename VTablePolicy>
+using poly = caramel::poly::Poly<Concept, caramel::poly::LocalStorage<8>, VTablePolicy>;
+
+using remote = caramel::poly::VTable<caramel::poly::Remote<caramel::poly::Everything>>;
+using local = caramel::poly::VTable<caramel::poly::Local<caramel::poly::Everything>>;
+
+template <typename VTablePolicy, typename ...Types>
+std::vector<poly<VTablePolicy>> make_polys(std::size_t size) {
+	std::vector<poly<VTablePolicy>> polys;
+	polys.reserve(size);
+	while (polys.size() != size) {
+		(polys.emplace_back(Types{}), ...);
+	}
+	return polys;
+}
+
+template <typename VTablePolicy, typename ...Types>
+static void BM_dispatch_virtual(benchmark::State& state) {
+	auto polys = make_polys<VTablePolicy, Types...>(static_cast<std::size_t>(state.range(0)));
+	while (state.KeepRunning()) {
+		for (auto& p : polys) {
+			p.invoke(f1_LABEL, p);
+		}
+		benchmark::ClobberMemory();
+	}
+}
+
+template <typename VTablePolicy, typename Likely, typename ...Types>
+static void BM_dispatch_likely(benchmark::State& state) {
+	auto polys = make_polys<VTablePolicy, Types...>(static_cast<std::size_t>(state.range(0)));
+	while (state.KeepRunning()) {
+		for (auto& p : polys) {
+			Likely::invoke(p);
+		}
+		benchmark::ClobberMemory();
+	}
+}
+
+template <typename ...Types>
+struct likely {
+	template <typename Poly>
+	static void invoke(Poly& p) {
+		p.template invokeLikely<Types...>(f1_LABEL, p);
+	}
+};
+
+using A = unsigned int;
+using B = unsigned long long;
+using C = unsigned short;
+
+static constexpr int N = 256;
+
+// Monomorphic call sites
+BENCHMARK_TEMPLATE(BM_dispatch_virtual, remote, A)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_likely, remote, likely<A>, A)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_virtual, local, A)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_likely, local, likely<A>, A)->Arg(N);
+
+// Bimorphic call sites
+BENCHMARK_TEMPLATE(BM_dispatch_virtual, remote, A, B)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_likely, remote, likely<A, B>, A, B)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_virtual, local, A, B)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_likely, local, likely<A, B>, A, B)->Arg(N);
+
+// Call sites where the guess is wrong
+BENCHMARK_TEMPLATE(BM_dispatch_virtual, remote, C)->Arg(N);
+BENCHMARK_TEMPLATE(BM_dispatch_likely, remote, likely<A, B>, C)->Arg(N);
@@ -36,3 +36,4 @@ BENCHMARK_TEMPLATE(BM_dispatch2, inheritance_tag)->Arg(D2_N);
 BENCHMARK_TEMPLATE(BM_dispatch2, inline_only<>)->Arg(D2_N);
 BENCHMARK_TEMPLATE(BM_dispatch2, inline_only<decltype(f1_LABEL)>)->Arg(D2_N);
 BENCHMARK_TEMPLATE(BM_dispatch2, inline_only<decltype(f1_LABEL), decltype(f2_LABEL)>)->Arg(D2_N);
+BENCHMARK_TEMPLATE(BM_dispatch2, sealed)->Arg(D2_N);
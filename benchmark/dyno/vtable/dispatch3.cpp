@@ -32,9 +32,15 @@ using inline_only = caramel::poly::VTable<
 	caramel::poly::Remote<caramel::poly::EverythingElse>
 >;
 
+struct f1_f2_profile {
+	static constexpr const char* HOT_FUNCTIONS[] = { "f1", "f2" };
+};
+
 static constexpr int N3 = 100;
 BENCHMARK_TEMPLATE(BM_dispatch3, inheritance_tag)->Arg(N3);
 BENCHMARK_TEMPLATE(BM_dispatch3, inline_only<>)->Arg(N3);
 BENCHMARK_TEMPLATE(BM_dispatch3, inline_only<decltype(f1_LABEL)>)->Arg(N3);
 BENCHMARK_TEMPLATE(BM_dispatch3, inline_only<decltype(f1_LABEL), decltype(f2_LABEL)>)->Arg(N3);
 BENCHMARK_TEMPLATE(BM_dispatch3, inline_only<decltype(f1_LABEL), decltype(f2_LABEL), decltype(f3_LABEL)>)->Arg(N3);
+BENCHMARK_TEMPLATE(BM_dispatch3, caramel::poly::AutoVTable<f1_f2_profile>)->Arg(N3);
+BENCHMARK_TEMPLATE(BM_dispatch3, sealed)->Arg(N3);
@@ -40,3 +40,4 @@ BENCHMARK_TEMPLATE(BM_dispatch4, inline_only<decltype(f1_LABEL)>)->Arg(N4);
 BENCHMARK_TEMPLATE(BM_dispatch4, inline_only<decltype(f1_LABEL), decltype(f2_LABEL)>)->Arg(N4);
 BENCHMARK_TEMPLATE(BM_dispatch4, inline_only<decltype(f1_LABEL), decltype(f2_LABEL), decltype(f3_LABEL)>)->Arg(N4);
 BENCHMARK_TEMPLATE(BM_dispatch4, inline_only<decltype(f1_LABEL), decltype(f2_LABEL), decltype(f3_LABEL), decltype(f4_LABEL)>)->Arg(N4);
+BENCHMARK_TEMPLATE(BM_dispatch4, sealed)->Arg(N4);
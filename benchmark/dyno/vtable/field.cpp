@@ -0,0 +1,117 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "caramel-poly/Poly.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+// This benchmark compares reading a member of the objects held in polys
+// through a method, which costs an indirect call, and through a field, which
+// is read at an offset held in the vtable, when sorting and filtering polys by
+// that member.
+
+constexpr auto key_LABEL = POLY_FUNCTION_LABEL("key");
+
+struct KeyedByMethod : decltype(caramel::poly::requires(
+	caramel::poly::MoveConstructible{},
+	key_LABEL = caramel::poly::method<int () const>
+)) { };
+
+struct KeyedByField : decltype(caramel::poly::requires(
+	caramel::poly::MoveConstructible{},
+	key_LABEL = caramel::poly::field<int>
+)) { };
+
+struct particle {
+	float position[3];
+	int key;
+};
+
+struct tagged_particle {
+	unsigned int tag;
+	particle p;
+	int key;
+};
+
+template <typename T>
+auto const caramel::poly::defaultConceptMap<KeyedByMethod, T, std::void_t<decltype(&T::key)>> =
+	caramel::poly::makeConceptMap(
+		key_LABEL = [](const T& self) -> int { return self.key; }
+	);
+
+template <typename T>
+auto const caramel::poly::defaultConceptMap<KeyedByField, T, std::void_t<decltype(&T::key)>> =
+	caramel::poly::makeConceptMap(
+		key_LABEL = caramel::poly::member<&T::key>
+	);
+
+struct method {
+	using poly = caramel::poly::Poly<KeyedByMethod>;
+
+	static int key(const poly& p) {
+		return p.invoke(key_LABEL);
+	}
+};
+
+struct field {
+	using poly = caramel::poly::Poly<KeyedByField>;
+
+	static int key(const poly& p) {
+		return p.field(key_LABEL);
+	}
+};
+
+template <typename Access>
+std::vector<typename Access::poly> make_polys(std::size_t size) {
+	std::vector<typename Access::poly> polys;
+	polys.reserve(size);
+	std::mt19937 random;
+	std::uniform_int_distribution<int> keys(0, 1 << 20);
+	while (polys.size() != size) {
+		polys.emplace_back(particle{ { 0.0f, 0.0f, 0.0f }, keys(random) });
+		polys.emplace_back(tagged_particle{ 0, { }, keys(random) });
+	}
+	return polys;
+}
+
+template <typename Access>
+static void BM_field_sort(benchmark::State& state) {
+	const auto polys = make_polys<Access>(static_cast<std::size_t>(state.range(0)));
+	std::vector<const typename Access::poly*> sorted(polys.size());
+
+	while (state.KeepRunning()) {
+		std::transform(polys.begin(), polys.end(), sorted.begin(), [](const auto& p) { return &p; });
+		std::sort(sorted.begin(), sorted.end(), [](const auto* lhs, const auto* rhs) {
+			return Access::key(*lhs) < Access::key(*rhs);
+		});
+		benchmark::DoNotOptimize(sorted.data());
+	}
+}
+
+template <typename Access>
+static void BM_field_filter(benchmark::State& state) {
+	const auto polys = make_polys<Access>(static_cast<std::size_t>(state.range(0)));
+
+	while (state.KeepRunning()) {
+		// Half of the keys pass, in random order, so the comparisons are added
+		// up rather than branched on.
+		auto count = std::size_t(0);
+		for (const auto& p : polys) {
+			count += static_cast<std::size_t>(Access::key(p) < (1 << 19));
+		}
+		benchmark::DoNotOptimize(count);
+	}
+}
+
+static constexpr int N = 1 << 16;
+
+BENCHMARK_TEMPLATE(BM_field_sort, method)->Arg(N);
+BENCHMARK_TEMPLATE(BM_field_sort, field)->Arg(N);
+BENCHMARK_TEMPLATE(BM_field_filter, method)->Arg(N);
+BENCHMARK_TEMPLATE(BM_field_filter, field)->Arg(N);
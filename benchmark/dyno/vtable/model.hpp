@@ -34,6 +34,10 @@ auto const caramel::poly::defaultConceptMap<Concept, T> = caramel::poly::makeCon
 	f4_LABEL = [](T& self) { ++self; benchmark::DoNotOptimize(self); }
 );
 
+// The vtable of the types stored by the dispatch benchmarks, dispatched on
+// a tag (see `caramel::poly::Sealed`).
+using sealed = caramel::poly::VTable<caramel::poly::Sealed<unsigned int, unsigned short, float>>;
+
 template <typename VTablePolicy>
 struct model {
 	template <typename T>
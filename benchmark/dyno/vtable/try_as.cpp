@@ -0,0 +1,98 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "caramel-poly/Poly.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <optional>
+#include <typeinfo>
+#include <vector>
+
+// This benchmark measures querying polys for a second concept and calling it
+// through a view, with `tryAs` and with a chain of `typeid` comparisons (as
+// done before `tryAs`), on objects of four types of which two model the
+// second concept.
+
+constexpr auto area_LABEL = POLY_FUNCTION_LABEL("area");
+constexpr auto serialize_LABEL = POLY_FUNCTION_LABEL("serialize");
+
+struct Shape : decltype(caramel::poly::requires(
+	caramel::poly::Castable{},
+	caramel::poly::TypeId{},
+	area_LABEL = caramel::poly::function<int (const caramel::poly::SelfPlaceholder&)>
+)) { };
+
+struct Serializable : decltype(caramel::poly::requires(
+	caramel::poly::Castable{},
+	serialize_LABEL = caramel::poly::function<int (const caramel::poly::SelfPlaceholder&)>
+)) { };
+
+template <int N>
+struct shape {
+	int value;
+};
+
+template <typename T>
+auto const caramel::poly::defaultConceptMap<Shape, T> = caramel::poly::makeConceptMap(
+	area_LABEL = [](const T& self) { return self.value; }
+);
+
+template <typename T>
+auto const caramel::poly::defaultConceptMap<Serializable, T> = caramel::poly::makeConceptMap(
+	serialize_LABEL = [](const T& self) { return self.value; }
+);
+
+using shape_poly = caramel::poly::Poly<Shape>;
+
+using serializable_poly = caramel::poly::Poly<Serializable>;
+
+using serializable_view = caramel::poly::Poly<Serializable, caramel::poly::NonOwningStorage>;
+
+// Make the serializable types known to `tryAs`.
+static const serializable_poly serializables[] = { shape<0>{ 0 }, shape<1>{ 1 } };
+
+struct try_as {
+	static std::optional<serializable_view> view(shape_poly& p) {
+		return p.tryAs<Serializable>();
+	}
+};
+
+struct typeid_chain {
+	static std::optional<serializable_view> view(shape_poly& p) {
+		const auto& type = p.invoke(caramel::poly::TYPEID_LABEL);
+		if (type == typeid(shape<0>)) {
+			return serializable_view(*p.unsafeGet<shape<0>>());
+		} else if (type == typeid(shape<1>)) {
+			return serializable_view(*p.unsafeGet<shape<1>>());
+		} else {
+			return std::nullopt;
+		}
+	}
+};
+
+template <typename Query>
+static void BM_try_as(benchmark::State& state) {
+	std::vector<shape_poly> polys;
+	polys.reserve(static_cast<std::size_t>(state.range(0)));
+	while (polys.size() != polys.capacity()) {
+		polys.emplace_back(shape<0>{ 1 });
+		polys.emplace_back(shape<2>{ 2 });
+		polys.emplace_back(shape<1>{ 3 });
+		polys.emplace_back(shape<3>{ 4 });
+	}
+
+	while (state.KeepRunning()) {
+		auto sum = 0;
+		for (auto& p : polys) {
+			if (const auto view = Query::view(p)) {
+				sum += view->invoke(serialize_LABEL, *view);
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_try_as, typeid_chain)->Arg(256);
+BENCHMARK_TEMPLATE(BM_try_as, try_as)->Arg(256);
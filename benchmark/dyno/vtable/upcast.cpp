@@ -0,0 +1,103 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include "model.hpp"
+
+#include "caramel-poly/Poly.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// This benchmark compares passing polys of a refined concept to code taking
+// polys of the base concept by wrapping them, which is what had to be done
+// before polys could be converted, and by converting them. It measures the
+// conversions themselves and calls made through the converted polys.
+
+constexpr auto f5_LABEL = POLY_FUNCTION_LABEL("f5");
+
+struct Refined : decltype(caramel::poly::requires(
+	Concept{},
+	caramel::poly::MoveConstructible{},
+	f5_LABEL = caramel::poly::function<void(caramel::poly::SelfPlaceholder&)>
+)) { };
+
+template <typename T>
+auto const caramel::poly::defaultConceptMap<Refined, T> = caramel::poly::makeConceptMap(
+	f5_LABEL = [](T& self) { ++self; benchmark::DoNotOptimize(self); }
+);
+
+using refined_poly = caramel::poly::Poly<Refined>;
+
+using base_poly = caramel::poly::Poly<Concept>;
+
+// A refined poly stored in a base poly. The functions of the base concept
+// increment their argument (see model.hpp), which this forwards to the
+// refined poly.
+struct wrapper {
+	wrapper& operator++() {
+		poly.invoke(f1_LABEL, poly);
+		return *this;
+	}
+
+	refined_poly poly;
+};
+
+struct wrapped {
+	static base_poly convert(const refined_poly& p) {
+		return base_poly(wrapper{ p });
+	}
+};
+
+struct upcast {
+	static base_poly convert(const refined_poly& p) {
+		return base_poly(p);
+	}
+};
+
+std::vector<refined_poly> make_polys(std::size_t size) {
+	std::vector<refined_poly> polys;
+	polys.reserve(size);
+	while (polys.size() != size) {
+		polys.emplace_back(static_cast<unsigned int>(polys.size()));
+		polys.emplace_back(static_cast<unsigned long long>(polys.size()));
+	}
+	return polys;
+}
+
+template <typename Conversion>
+static void BM_upcast_convert(benchmark::State& state) {
+	auto polys = make_polys(static_cast<std::size_t>(state.range(0)));
+	while (state.KeepRunning()) {
+		for (const auto& p : polys) {
+			auto converted = Conversion::convert(p);
+			benchmark::DoNotOptimize(converted);
+		}
+	}
+}
+
+template <typename Conversion>
+static void BM_upcast_dispatch(benchmark::State& state) {
+	auto refined = make_polys(static_cast<std::size_t>(state.range(0)));
+	std::vector<base_poly> polys;
+	polys.reserve(refined.size());
+	for (const auto& p : refined) {
+		polys.push_back(Conversion::convert(p));
+	}
+
+	while (state.KeepRunning()) {
+		for (auto& p : polys) {
+			p.invoke(f1_LABEL, p);
+		}
+		benchmark::ClobberMemory();
+	}
+}
+
+static constexpr int N = 256;
+
+BENCHMARK_TEMPLATE(BM_upcast_convert, wrapped)->Arg(N);
+BENCHMARK_TEMPLATE(BM_upcast_convert, upcast)->Arg(N);
+BENCHMARK_TEMPLATE(BM_upcast_dispatch, wrapped)->Arg(N);
+BENCHMARK_TEMPLATE(BM_upcast_dispatch, upcast)->Arg(N);
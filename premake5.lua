@@ -82,6 +82,11 @@ workspace "caramel-poly"
 
 	structure.executable_project("caramel-poly-benchmark", "benchmark", false, function()
 			use_googlebenchmark()
+
+			-- measures dispatch where not everything gets inlined
+			filter { "action:gmake", "configurations:Release*", "files:benchmark/dyno/vtable/dispatch.cached.O1.cpp" }
+				buildoptions { "-O1" }
+			filter {}
 		end
 		)
 
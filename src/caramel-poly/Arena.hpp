@@ -0,0 +1,144 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_ARENA_HPP__
+#define CARAMELPOLY_ARENA_HPP__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace caramel::poly {
+
+// Monotonic memory arena.
+//
+// Memory is bump-allocated from a chain of blocks obtained from `std::malloc`.
+// Individual allocations are never freed; instead, `reset` rewinds the arena
+// to its first block in constant time, keeping all the blocks around so that
+// the next round of allocations doesn't need to go to the system allocator.
+// The blocks are only released when the arena is destroyed.
+//
+// The arena is not thread-safe. It does not know about the objects placed in
+// it, so it is up to the user to destroy them (for instance by destroying the
+// `Poly`s using `ArenaStorage`) before calling `reset` or destroying the arena.
+class Arena {
+public:
+
+	static constexpr std::size_t DEFAULT_BLOCK_SIZE = 4096;
+
+	explicit Arena(std::size_t blockSize = DEFAULT_BLOCK_SIZE) :
+		blockSize_(blockSize)
+	{
+	}
+
+	Arena(const Arena&) = delete;
+	Arena(Arena&&) = delete;
+	Arena& operator=(const Arena&) = delete;
+	Arena& operator=(Arena&&) = delete;
+
+	~Arena() {
+		auto* block = first_;
+		while (block != nullptr) {
+			auto* next = block->next;
+			std::free(block);
+			block = next;
+		}
+	}
+
+	// Returns `size` bytes aligned to `alignment`, which must be a power of two.
+	// Returns nullptr if the system allocator fails.
+	void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0 &&
+			"caramel::poly::Arena::allocate: alignment must be a power of two");
+
+		auto* ptr = alignUp(cursor_, alignment);
+		if (ptr == nullptr || ptr + size > end_) {
+			ptr = alignUp(nextBlock(size + alignment - 1), alignment);
+			if (ptr == nullptr) {
+				return nullptr;
+			}
+		}
+
+		cursor_ = ptr + size;
+		return ptr;
+	}
+
+	// Releases all allocations at once. The memory is kept for reuse.
+	void reset() noexcept {
+		current_ = first_;
+		if (current_ != nullptr) {
+			cursor_ = current_->data();
+			end_ = cursor_ + current_->size;
+		}
+	}
+
+	// Total number of bytes held by the arena, used or not.
+	std::size_t capacity() const noexcept {
+		auto result = std::size_t(0);
+		for (auto* block = first_; block != nullptr; block = block->next) {
+			result += block->size;
+		}
+		return result;
+	}
+
+private:
+
+	struct alignas(std::max_align_t) Block {
+		Block* next;
+		std::size_t size;
+
+		unsigned char* data() noexcept {
+			return reinterpret_cast<unsigned char*>(this + 1);
+		}
+	};
+
+	std::size_t blockSize_;
+
+	Block* first_ = nullptr;
+
+	Block* current_ = nullptr;
+
+	unsigned char* cursor_ = nullptr;
+
+	unsigned char* end_ = nullptr;
+
+	static unsigned char* alignUp(unsigned char* ptr, std::size_t alignment) noexcept {
+		const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+		const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+		return ptr + (aligned - address);
+	}
+
+	// Moves on to a block holding at least `size` bytes, reusing the blocks
+	// retained by a previous `reset` when they are large enough.
+	unsigned char* nextBlock(std::size_t size) {
+		auto* next = (current_ == nullptr) ? first_ : current_->next;
+		if (next == nullptr || next->size < size) {
+			const auto newSize = (size < blockSize_) ? blockSize_ : size;
+			auto* block = static_cast<Block*>(std::malloc(sizeof(Block) + newSize));
+			if (block == nullptr) {
+				return nullptr;
+			}
+
+			new (block) Block{ next, newSize };
+
+			if (current_ == nullptr) {
+				first_ = block;
+			} else {
+				current_->next = block;
+			}
+			next = block;
+		}
+
+		current_ = next;
+		cursor_ = current_->data();
+		end_ = cursor_ + current_->size;
+		return cursor_;
+	}
+
+};
+
+} // namespace caramel::poly
+
+#endif /* CARAMELPOLY_ARENA_HPP__ */
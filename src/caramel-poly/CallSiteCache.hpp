@@ -0,0 +1,111 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_CALLSITECACHE_HPP__
+#define CARAMELPOLY_CALLSITECACHE_HPP__
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Poly.hpp"
+
+namespace caramel::poly {
+
+// Remembers the function found for `Function` in the last vtable seen at a
+// call site, so that calling it again on an object built from the same concept
+// map skips the lookup.
+//
+// The vtables are told apart by the shared table the function is read from
+// (see `sharedTable` in the `VTable` concept), so a hit costs a comparison of
+// that pointer instead of the load of the function from it. Functions held in
+// local vtables are read directly and don't go through the cache.
+//
+// The function is called straight away with the erased arguments, hit or
+// miss, without going through the function `Poly::virtual_` returns.
+//
+// With optimizations on, looking a function up in a remote vtable is already
+// just two loads, which the cache can't beat. The cache pays off where the
+// lookup isn't optimized away, as in debug builds or with `-O1`, where it
+// goes through a chain of calls (more so for joined vtables).
+//
+// A cache is meant to be used from a single thread. `hits` and `misses` count
+// the lookups made since construction or the last `reset`, to help decide
+// which call sites benefit from caching; long runs of objects of the same
+// type should hit almost always.
+template <class Poly, class Function>
+class CallSiteCache {
+public:
+
+	template <class... Args>
+	decltype(auto) invoke(Poly& poly, Args&&... args) {
+		return detail::PolyAccess::call(poly, Function{}, lookup(poly), std::forward<Args>(args)...);
+	}
+
+	template <class... Args>
+	decltype(auto) invoke(const Poly& poly, Args&&... args) {
+		return detail::PolyAccess::call(poly, Function{}, lookup(poly), std::forward<Args>(args)...);
+	}
+
+	std::size_t hits() const noexcept {
+		return hits_;
+	}
+
+	std::size_t misses() const noexcept {
+		return misses_;
+	}
+
+	void reset() noexcept {
+		table_ = nullptr;
+		hits_ = 0;
+		misses_ = 0;
+	}
+
+private:
+
+	using FunctionPtr = decltype(detail::PolyAccess::vtable(std::declval<const Poly&>())[Function{}]);
+
+	const void* table_ = nullptr;
+
+	FunctionPtr function_ = nullptr;
+
+	std::size_t hits_ = 0;
+
+	std::size_t misses_ = 0;
+
+	FunctionPtr lookup(const Poly& poly) noexcept {
+		const auto& vtable = detail::PolyAccess::vtable(poly);
+		const auto* table = vtable.sharedTable(Function{});
+		if (table == nullptr) {
+			return vtable[Function{}];
+		}
+
+		if (table == table_) {
+			++hits_;
+			return function_;
+		}
+
+		++misses_;
+		table_ = table;
+		function_ = vtable[Function{}];
+		return function_;
+	}
+
+};
+
+} // namespace caramel::poly
+
+// Calls the function `name` on `poly` through a `CallSiteCache` private to
+// this call site (and thread), passing it any further arguments, as in
+// `POLY_CACHED_INVOKE(SHAPE_DRAW_LABEL, shape, canvas)`. Use a `CallSiteCache`
+// directly to look at its statistics.
+#define POLY_CACHED_INVOKE(name, ...)                                             \
+	([](auto& cachedPoly, auto&&... cachedArgs) -> decltype(auto) {              \
+		static thread_local ::caramel::poly::CallSiteCache<                        \
+			std::remove_const_t<std::remove_reference_t<decltype(cachedPoly)>>,     \
+			std::decay_t<decltype(name)>                                            \
+			> cache;                                                                \
+		return cache.invoke(cachedPoly, std::forward<decltype(cachedArgs)>(cachedArgs)...); \
+	}(__VA_ARGS__))
+
+#endif /* CARAMELPOLY_CALLSITECACHE_HPP__ */
@@ -9,6 +9,8 @@
 #ifndef CARAMELPOLY_CONCEPT_HPP__
 #define CARAMELPOLY_CONCEPT_HPP__
 
+#include <cstddef>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -67,6 +69,52 @@ constexpr auto refinedConcepts(const Concept<Clauses...>&) {
 		});
 }
 
+// Returns a sequence of all the Concepts refined by the given Concept, directly
+// or through the Concepts it refines. A Concept refined along several paths
+// appears once per path.
+template <class... Clauses>
+constexpr auto allRefinedConcepts(const Concept<Clauses...>& c) {
+	return flatten(transform(refinedConcepts(c), [](auto refined) {
+			return prepend(allRefinedConcepts(refined), refined);
+		}));
+}
+
+template <class Indices, class... Clauses>
+struct SubConcepts;
+
+template <std::size_t... INDICES, class... Clauses>
+struct SubConcepts<std::index_sequence<INDICES...>, Clauses...> {
+
+	template <std::size_t INDEX, class Replacement>
+	using Replaced = Concept<std::conditional_t<INDICES == INDEX, Replacement, Clauses>...>;
+
+	template <std::size_t INDEX>
+	static constexpr auto replacing() {
+		using Clause = std::tuple_element_t<INDEX, std::tuple<Clauses...>>;
+		if constexpr (std::is_base_of_v<ConceptBase, Clause>) {
+			return transform(allRefinedConcepts(Clause{}), [](auto refined) {
+					return Replaced<INDEX, decltype(refined)>{};
+				});
+		} else {
+			return makeConstexprList();
+		}
+	}
+
+	using Type = decltype(flatten(makeConstexprList(replacing<INDICES>()...)));
+
+};
+
+// Returns a sequence of the Concepts made from the given Concept by replacing
+// one of the Concepts it refines with a Concept that one refines, directly or
+// not. For example, the concept of a `Poly` of a concept `B` refining `A` is
+// `Concept<B, Destructible, Storable>`, which gives `Concept<A, Destructible,
+// Storable>`, the concept of a `Poly` of `A`, among others. The given Concept
+// has all the clauses of each of them. A Concept may appear more than once.
+template <class... Clauses>
+constexpr auto subConcepts(const Concept<Clauses...>&) {
+	return typename SubConcepts<std::index_sequence_for<Clauses...>, Clauses...>::Type{};
+}
+
 template <class... Clauses>
 constexpr auto directClauses(const Concept<Clauses...>&) {
 	return filter(detail::makeConstexprList(Clauses{}...), [](auto t) {
@@ -89,6 +137,23 @@ constexpr auto isRedefiningBaseConceptClause(const Concept<Clauses...>& c) {
 		});
 }
 
+// Returns whether `c` has all the clauses of `other`, with the same
+// signatures, e.g. because it refines `other`.
+template <class... Clauses, class Other>
+constexpr bool hasClausesOf(const Concept<Clauses...>&, Other other) {
+	return allOf(clauses(other), [](auto clause) {
+			using Name = decltype(clause.first());
+			if constexpr (contains(clauseNames(Concept<Clauses...>{}), Name{})) {
+				return std::is_same_v<
+					typename decltype(clause.second())::Type,
+					typename decltype(Concept<Clauses...>{}.getSignature(Name{}))::Type
+					>;
+			} else {
+				return false;
+			}
+		});
+}
+
 } // namespace detail
 
 // A `Concept` is a collection of clauses and refined Concepts representing
@@ -9,10 +9,12 @@
 #ifndef CARAMELPOLY_CONCEPTMAP_HPP__
 #define CARAMELPOLY_CONCEPTMAP_HPP__
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
 #include "detail/DefaultConstructibleLambda.hpp"
+#include "detail/EmptyObject.hpp"
 #include "detail/ConstexprPair.hpp"
 #include "detail/ConstexprMap.hpp"
 #include "detail/BindSignature.hpp"
@@ -32,6 +34,97 @@ namespace caramel::poly {
 template <class Concept, class T, class... Mappings>
 struct ConceptMap;
 
+namespace detail {
+
+// Implements a `batchMethod` clause with a function given for it in a concept
+// map. If the function can't take the array of objects, it is called on each
+// object in turn.
+template <class LambdaType, class Signature>
+struct BatchLambda;
+
+template <class LambdaType, class T, class... Args>
+struct BatchLambda<LambdaType, void (T*, std::size_t, Args...)> {
+
+	void operator()(T* objects, std::size_t count, Args... args) const {
+		const auto lambda = caramel::poly::detail::EmptyObject<LambdaType>{}.get();
+		if constexpr (std::is_invocable_v<const LambdaType&, T*, std::size_t, Args...>) {
+			lambda(objects, count, std::forward<Args>(args)...);
+		} else {
+			static_assert(std::is_invocable_v<const LambdaType&, T&, Args&...>,
+				"caramel::poly::batchMethod: The function in the concept map must take either a "
+				"pointer to the objects and their number, or a single object, followed by the "
+				"arguments of the method.");
+			for (auto i = std::size_t(0); i != count; ++i) {
+				lambda(objects[i], args...);
+			}
+		}
+	}
+
+};
+
+// Gives the offset of the data member bound to a field clause (see
+// `caramel::poly::field`) within the objects of the model.
+template <class MemberType, class Signature>
+struct FieldOffset {
+	static_assert(!std::is_same_v<MemberType, MemberType>,
+		"caramel::poly::field: Fields must be bound to data members with caramel::poly::member.");
+};
+
+template <auto MEMBER, class T, class Model>
+struct FieldOffset<caramel::poly::Member<MEMBER>, T& (Model&)> {
+
+	std::ptrdiff_t operator()() const noexcept {
+		using MemberType = std::remove_reference_t<decltype(std::declval<Model&>().*MEMBER)>;
+		static_assert(std::is_same_v<std::remove_cv_t<T>, MemberType>,
+			"caramel::poly::field: The type of the member must be the type of the field.");
+		// The offset is read from a model that was never constructed, so it must
+		// not depend on where virtual bases are placed, which only a constructed
+		// object knows.
+		static_assert(std::is_convertible_v<decltype(MEMBER), MemberType Model::*>,
+			"caramel::poly::field: The member must not belong to a virtual base of the model.");
+		alignas(Model) unsigned char object[sizeof(Model)];
+		const auto* member = &(reinterpret_cast<Model*>(object)->*MEMBER);
+		return reinterpret_cast<const unsigned char*>(member) - object;
+	}
+
+};
+
+// The type of the function object stored in a concept map for the given clause.
+template <class Clause, class LambdaType, class Signature>
+struct ConceptMapEntry {
+	using Type = DefaultConstructibleLambda<LambdaType, Signature>;
+};
+
+template <class MethodSignature, class LambdaType, class Signature>
+struct ConceptMapEntry<caramel::poly::BatchMethod<MethodSignature>, LambdaType, Signature> {
+	using Type = DefaultConstructibleLambda<BatchLambda<LambdaType, Signature>, Signature>;
+};
+
+// Function objects given for constants that are default constructible, unlike
+// lambdas, are kept as they are, so that vtables may call them at compile time
+// (see `caramel::poly::constant`).
+template <class T, class LambdaType, class Signature>
+struct ConceptMapEntry<caramel::poly::Constant<T>, LambdaType, Signature> {
+	using Type = std::conditional_t<
+		std::is_default_constructible_v<LambdaType>,
+		LambdaType,
+		DefaultConstructibleLambda<LambdaType, Signature>
+		>;
+};
+
+template <class T, class MemberType, class Signature>
+struct ConceptMapEntry<caramel::poly::Field<T>, MemberType, Signature> {
+	using Type = FieldOffset<MemberType, Signature>;
+};
+
+template <class Clause, class LambdaType, class Signature>
+struct ConceptMapEntry<caramel::poly::Hot<Clause>, LambdaType, Signature> :
+	ConceptMapEntry<Clause, LambdaType, Signature>
+{
+};
+
+} // namespace detail
+
 template <class Concept, class T, class... Name, class... Function>
 struct ConceptMap<Concept, T, detail::ConstexprPair<Name, Function>...> {
 	
@@ -61,12 +154,13 @@ private:
 	using Functions = detail::ConstexprMap<
 		detail::ConstexprPair<
 			Name,
-			detail::DefaultConstructibleLambda<
+			typename detail::ConceptMapEntry<
+				decltype(Concept{}.getSignature(Name{})),
 				Function,
 				typename detail::BindSignature<
 					typename decltype(Concept{}.getSignature(Name{}))::Type, T
 					>::Type
-				>
+				>::Type
 			>...
 		>;
 
@@ -153,6 +247,37 @@ constexpr auto conceptMapIsComplete = isSubset(
 	keys(Map{})
 	);
 
+// The function mapped to `Name` in a list of constexpr pairs, or `void` if
+// there is none.
+template <class Name, class Entries>
+struct MappedFunction {
+	using Type = void;
+};
+
+template <class Name, class Key, class Value, class... Entries>
+struct MappedFunction<Name, ConstexprList<ConstexprPair<Key, Value>, Entries...>> {
+	using Type = std::conditional_t<
+		std::is_same_v<Name, Key>,
+		Value,
+		typename MappedFunction<Name, ConstexprList<Entries...>>::Type
+		>;
+};
+
+// Customization point for functions of default concept maps that are built
+// from other functions of the complete concept map `Map`. For example, the
+// default relocation goes through the move constructor and destructor the map
+// ends up with (see `caramel::poly::Relocatable`).
+template <class Function, class Map>
+struct ResolvedFunction {
+	using Type = Function;
+};
+
+template <class... Keys, class... Values>
+constexpr auto resolveFunctions(ConstexprMap<ConstexprPair<Keys, Values>...>) {
+	using Map = ConstexprMap<ConstexprPair<Keys, Values>...>;
+	return ConstexprMap<ConstexprPair<Keys, typename ResolvedFunction<Values, Map>::Type>...>{};
+}
+
 } // namespace detail
 
 // Returns whether the type `T` models the given `Concept`.
@@ -240,7 +365,7 @@ namespace diagnostic {
 // be resolved.
 template <class Concept, class T, class Map>
 constexpr auto completeConceptMap(Map map) {
-	auto completeMap = detail::completeConceptMapImpl<Concept, T>(map);
+	auto completeMap = detail::resolveFunctions(detail::completeConceptMapImpl<Concept, T>(map));
 	auto asConceptMap = detail::toConceptMap<Concept, T>(completeMap);
 	
 	constexpr auto isComplete = detail::conceptMapIsComplete<Concept, T, decltype(completeMap)>;
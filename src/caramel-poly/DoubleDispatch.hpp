@@ -0,0 +1,130 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_DOUBLEDISPATCH_HPP__
+#define CARAMELPOLY_DOUBLEDISPATCH_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/EraseFunction.hpp"
+#include "detail/EraseSignature.hpp"
+#include "detail/isPlaceholder.hpp"
+#include "Poly.hpp"
+
+namespace caramel::poly {
+
+// A function of two polys picked by the types of both of the objects they
+// hold, as for collisions between shapes.
+//
+// `Signature` is the signature of the function, whose first two parameters
+// are the objects, as placeholders (e.g. `bool (const SelfPlaceholder&,
+// const SelfPlaceholder&, double)`). The functions for pairs of types are
+// stateless function objects taking the actual types instead, defined with
+// `define`.
+//
+// The functions are held in a dense table, indexed by the indices of the
+// vtables of the objects, so the polys must have indexed vtables (see
+// `Indexed`). Calling the function then costs the loads of the two indices
+// and of the function, and an indirect call, whatever the number of types.
+// Calling it for a pair of types with no function defined throws
+// `std::out_of_range`; check with `contains` first where that is expected.
+//
+// The table grows as functions are defined. Define them all before making
+// calls from other threads.
+template <class Signature, class PolyA, class PolyB = PolyA>
+class DoubleDispatch {
+public:
+
+	// Makes `F` the function called for objects of types `A` and `B`.
+	template <class A, class B, class F>
+	void define(F f) {
+		const auto row = indexOf<PolyA, A>();
+		const auto column = indexOf<PolyB, B>();
+		if (row >= rows_ || column >= columns_) {
+			resize(std::max(rows_, row + 1), std::max(columns_, column + 1));
+		}
+		functions_[row * columns_ + column] = detail::EraseFunction<Signature>(f);
+	}
+
+	// Whether a function is defined for the types of the objects of `a` and
+	// `b`.
+	bool contains(const PolyA& a, const PolyB& b) const noexcept {
+		return find(a, b) != nullptr;
+	}
+
+	// Calls the function defined for the types of the objects of `a` and `b`,
+	// passing it any further arguments. Throws `std::out_of_range` if there is
+	// none.
+	template <class PA, class PB, class... Args>
+	decltype(auto) operator()(PA&& a, PB&& b, Args&&... args) const {
+		static_assert(std::is_same_v<std::decay_t<PA>, PolyA> && std::is_same_v<std::decay_t<PB>, PolyB>,
+			"caramel::poly::DoubleDispatch: The objects must be passed in polys of the types of the table.");
+		const auto function = find(a, b);
+		if (function == nullptr) {
+			throw std::out_of_range("caramel::poly::DoubleDispatch: No function defined for the types of the objects");
+		}
+		return function(
+			detail::PolyAccess::objectFor<typename detail::PlaceholderParameter<0, Signature>::Type>(a),
+			detail::PolyAccess::objectFor<typename detail::PlaceholderParameter<1, Signature>::Type>(b),
+			std::forward<Args>(args)...);
+	}
+
+private:
+
+	using FunctionPtr = typename detail::EraseSignature<Signature>::Type*;
+
+	std::vector<FunctionPtr> functions_;
+
+	std::size_t rows_ = 0;
+
+	std::size_t columns_ = 0;
+
+	template <class Poly, class T>
+	static std::size_t indexOf() {
+		using Concept = detail::PolyAccess::Concept<Poly>;
+		using VTable = std::decay_t<decltype(detail::PolyAccess::vtable(std::declval<const Poly&>()))>;
+		static_assert(detail::isIndexedVTable<VTable>,
+			"caramel::poly::DoubleDispatch: The polys must have indexed vtables.");
+		static_assert(caramel::poly::models<Concept, T>,
+			"caramel::poly::DoubleDispatch: A type does not model the concept of its poly.");
+		using ConceptMap = decltype(caramel::poly::completeConceptMap<Concept, T>(
+			caramel::poly::conceptMap<Concept, T>));
+		return VTable::indexOf(ConceptMap{});
+	}
+
+	FunctionPtr find(const PolyA& a, const PolyB& b) const noexcept {
+		const auto row = static_cast<std::size_t>(detail::PolyAccess::vtable(a).index());
+		const auto column = static_cast<std::size_t>(detail::PolyAccess::vtable(b).index());
+		if (row >= rows_ || column >= columns_) {
+			return nullptr;
+		}
+		return functions_[row * columns_ + column];
+	}
+
+	void resize(std::size_t rows, std::size_t columns) {
+		auto functions = std::vector<FunctionPtr>(rows * columns, nullptr);
+		for (auto row = std::size_t(0); row != rows_; ++row) {
+			std::copy_n(functions_.data() + row * columns_, columns_, functions.data() + row * columns);
+		}
+		functions_ = std::move(functions);
+		rows_ = rows;
+		columns_ = columns;
+	}
+
+};
+
+// Calls `function` on `a` and `b`, and any further arguments. See
+// `DoubleDispatch`.
+template <class Signature, class PolyA, class PolyB, class PA, class PB, class... Args>
+decltype(auto) dispatch2(const DoubleDispatch<Signature, PolyA, PolyB>& function, PA&& a, PB&& b, Args&&... args) {
+	return function(std::forward<PA>(a), std::forward<PB>(b), std::forward<Args>(args)...);
+}
+
+} // namespace caramel::poly
+
+#endif /* CARAMELPOLY_DOUBLEDISPATCH_HPP__ */
@@ -9,18 +9,134 @@
 #ifndef CARAMELPOLY_POLY_HPP__
 #define CARAMELPOLY_POLY_HPP__
 
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
+#include "detail/EraseFunction.hpp"
 #include "detail/isPlaceholder.hpp"
 #include "builtin.hpp"
 #include "Concept.hpp"
 #include "ConceptMap.hpp"
+#include "relocation.hpp"
 #include "storage.hpp"
 #include "vtable.hpp"
 
 namespace caramel::poly {
 
+namespace detail {
+
+template <class Storage, class VTable, class = void>
+constexpr bool hasMutableGet = false;
+
+template <class Storage, class VTable>
+constexpr bool hasMutableGet<
+	Storage,
+	VTable,
+	std::void_t<decltype(std::declval<Storage&>().get(std::declval<const VTable&>()))>
+	> = true;
+
+// Whether getting the object through `get(vtable)` can't throw, as it may
+// when the storage gives the poly its own copy first.
+template <class Storage, class VTable, class = void>
+constexpr bool isNothrowMutableGet = true;
+
+template <class Storage, class VTable>
+constexpr bool isNothrowMutableGet<Storage, VTable, std::enable_if_t<hasMutableGet<Storage, VTable>>> =
+	noexcept(std::declval<Storage&>().get(std::declval<const VTable&>()));
+
+template <class Storage, class VTable, class = void>
+constexpr bool hasConstGet = false;
+
+template <class Storage, class VTable>
+constexpr bool hasConstGet<
+	Storage,
+	VTable,
+	std::void_t<decltype(std::declval<const Storage&>().get(std::declval<const VTable&>()))>
+	> = true;
+
+// Gives the library's algorithms (like `invokeAll`) access to the insides of
+// a `Poly`.
+struct PolyAccess {
+
+	template <class Poly>
+	using Concept = typename Poly::ActualConcept;
+
+	template <class Poly>
+	using VTable = typename Poly::VTable;
+
+	// The signature of the function `Name` of `Poly`.
+	template <class Poly, class Name>
+	struct Signature {
+		using Type = typename decltype(typename Poly::ActualConcept{}.getSignature(Name{}))::Type;
+	};
+
+	template <class Poly>
+	static const auto& vtable(const Poly& poly) noexcept {
+		return poly.vtable_;
+	}
+
+	template <class Poly>
+	static void* object(Poly& poly) {
+		return poly.mutableGet();
+	}
+
+	template <class Poly>
+	static const void* object(const Poly& poly) {
+		return poly.constGet();
+	}
+
+	// The object of `poly`, to be passed for the placeholder `Placeholder`.
+	// It is read through `poly` as const if the placeholder is, so that a
+	// storage sharing objects (as `CowStorage`) doesn't copy the object for a
+	// function that can't modify it.
+	template <class Placeholder, class Poly>
+	static auto objectFor(Poly& poly) {
+		if constexpr (isConstPlaceholder<Placeholder>) {
+			return object(std::as_const(poly));
+		} else {
+			return object(poly);
+		}
+	}
+
+	// Calls the function `name` of `poly` through `function`, which must be the
+	// function the vtable of `poly` holds for `name`.
+	template <class Poly, class Function, class FunctionPtr, class... Args>
+	static decltype(auto) invoke(Poly& poly, Function name, FunctionPtr function, Args&&... args) {
+		return std::remove_const_t<Poly>::invokeThrough(poly, name, function, std::forward<Args>(args)...);
+	}
+
+	// Calls `function` like `invoke`, passing it the erased arguments
+	// directly (see `Poly::callErased`).
+	template <class Poly, class Function, class FunctionPtr, class... Args>
+	static decltype(auto) call(Poly& poly, Function name, FunctionPtr function, Args&&... args) {
+		return std::remove_const_t<Poly>::callErased(poly, name, function, std::forward<Args>(args)...);
+	}
+
+};
+
+// Records the shared table `Table` built from `ConceptMap` as the vtable of
+// `Concept` for `T`, in the table of the concepts of `T`, when the program
+// starts.
+template <class Concept, class T, class Table, class ConceptMap>
+inline const bool CONCEPT_RECORDED =
+	(CONCEPT_TABLE<T>.record(ConceptTable::indexOf<Concept>(), staticVTable<Table, ConceptMap>()), true);
+
+// Whether a `Source` poly has all the clauses of a `Target` poly with the
+// same storage, in which case it is converted rather than wrapped, if it can
+// be (see `Poly`).
+template <class Target, class Source>
+constexpr bool isRefinedPoly = false;
+
+// Whether a `Target` poly can be converted from a `Source` poly without
+// wrapping it.
+template <class Target, class Source>
+constexpr bool isUpcastable = false;
+
+} // namespace detail
+
 // A `caramel::poly::Poly` encapsulates an object of a polymorphic type that supports the
 // interface of the given `Concept`.
 //
@@ -71,6 +187,26 @@ private:
 		caramel::poly::Storable{}
 		));
 
+	using VTable = typename VTablePolicy::template Type<ActualConcept>;
+
+	static constexpr bool NOTHROW_MOVE_CONSTRUCTIBLE =
+		std::is_nothrow_move_constructible_v<VTable> &&
+		std::is_nothrow_constructible_v<Storage, Storage&&, const VTable&>;
+
+	static constexpr bool IS_CASTABLE =
+		contains(caramel::poly::detail::clauseNames(ActualConcept{}), caramel::poly::CONCEPTS_LABEL);
+
+	// The vtables recorded for `tryAs`, which the views it returns refer to.
+	using CastVTable = detail::SharedTable<
+		typename caramel::poly::VTable<caramel::poly::Local<caramel::poly::Everything>>::template Type<ActualConcept>,
+		ActualConcept
+		>;
+
+	static constexpr bool NOTHROW_SWAPPABLE =
+		std::is_nothrow_swappable_v<VTable> &&
+		noexcept(std::declval<Storage&>().swap(
+			std::declval<const VTable&>(), std::declval<Storage&>(), std::declval<const VTable&>()));
+
 public:
 
 	template <class T, class RawT = std::decay_t<T>, class ConceptMap>
@@ -84,11 +220,39 @@ public:
 		class T,
 		class RawT = std::decay_t<T>,
 		class = std::enable_if_t<!std::is_same<RawT, Poly>::value>,
+		class = std::enable_if_t<!detail::isRefinedPoly<Poly, RawT>>,
 		class = std::enable_if_t<caramel::poly::models<ActualConcept, RawT>>
 		>
 	Poly(T&& t) :
 		Poly{std::forward<T>(t), caramel::poly::conceptMap<ActualConcept, RawT>}
 	{
+		recordConcept<RawT>();
+	}
+
+	// Construct the storage from the given resource (such as an `Arena`), for
+	// storage policies that need one. See `PolymorphicStorage`.
+	template <class Resource, class T, class RawT = std::decay_t<T>, class ConceptMap>
+	Poly(std::allocator_arg_t, Resource&& resource, T&& t, ConceptMap map) :
+		vtable_{caramel::poly::completeConceptMap<ActualConcept, RawT>(map)},
+		storage_{std::allocator_arg, std::forward<Resource>(resource), std::forward<T>(t)}
+	{
+	}
+
+	template <
+		class Resource,
+		class T,
+		class RawT = std::decay_t<T>,
+		class = std::enable_if_t<caramel::poly::models<ActualConcept, RawT>>
+		>
+	Poly(std::allocator_arg_t, Resource&& resource, T&& t) :
+		Poly{
+			std::allocator_arg,
+			std::forward<Resource>(resource),
+			std::forward<T>(t),
+			caramel::poly::conceptMap<ActualConcept, RawT>
+			}
+	{
+		recordConcept<RawT>();
 	}
 
 	~Poly() {
@@ -101,7 +265,47 @@ public:
 	{
 	}
 
-	Poly(Poly&& other) :
+	// Converts a poly of a concept refining `Concept` (or otherwise having all
+	// of its clauses) with the same storage policy, as when passing it to a
+	// function taking a poly of the base concept. The vtable policies may
+	// differ, so this also converts between polys of the same concept.
+	//
+	// The object isn't wrapped: the storage is moved (or copied) over as with
+	// polys of the same type, so this only allocates where a move would, and
+	// the vtable is built from the functions of the vtable of `other`, so
+	// calls go straight to the functions of the object's concept map. Local
+	// vtables are filled in with a copy of each function. Remote and indexed
+	// ones refer to the shared table built for the object's type along with
+	// the shared table of `other` (see `detail::SharedTable`), which costs a
+	// load at most, or to the table of its type for sealed vtables. Polys
+	// holding all their functions locally have no shared table to slice, so
+	// they may only be converted to polys with local (or sealed) vtables, and
+	// the shared part of the vtable of this poly must hold exactly the
+	// functions of `Concept` the shared part of the vtable of `other` holds,
+	// as it does when both use the same vtable policies.
+	template <
+		class OtherConcept,
+		class OtherVTablePolicy,
+		class = std::enable_if_t<detail::isUpcastable<Poly, Poly<OtherConcept, Storage, OtherVTablePolicy>>>
+		>
+	Poly(Poly<OtherConcept, Storage, OtherVTablePolicy>&& other) :
+		vtable_{detail::SliceTag{}, other.vtable_},
+		storage_{std::move(other.storage_), other.vtable_}
+	{
+	}
+
+	template <
+		class OtherConcept,
+		class OtherVTablePolicy,
+		class = std::enable_if_t<detail::isUpcastable<Poly, Poly<OtherConcept, Storage, OtherVTablePolicy>>>
+		>
+	Poly(const Poly<OtherConcept, Storage, OtherVTablePolicy>& other) :
+		vtable_{detail::SliceTag{}, other.vtable_},
+		storage_{other.storage_, other.vtable_}
+	{
+	}
+
+	Poly(Poly&& other) noexcept(NOTHROW_MOVE_CONSTRUCTIBLE) :
 		vtable_{std::move(other.vtable_)},
 		storage_{std::move(other.storage_), vtable_}
 	{
@@ -112,18 +316,18 @@ public:
 		return *this;
 	}
 
-	Poly& operator=(Poly&& other) {
+	Poly& operator=(Poly&& other) noexcept(NOTHROW_MOVE_CONSTRUCTIBLE && NOTHROW_SWAPPABLE) {
 		Poly(std::move(other)).swap(*this);
 		return *this;
 	}
 
-	void swap(Poly& other) {
+	void swap(Poly& other) noexcept(NOTHROW_SWAPPABLE) {
 		storage_.swap(vtable_, other.storage_, other.vtable_);
 		using std::swap;
 		swap(vtable_, other.vtable_);
 	}
 
-	friend void swap(Poly& a, Poly& b) {
+	friend void swap(Poly& a, Poly& b) noexcept(NOTHROW_SWAPPABLE) {
 		a.swap(b);
 	}
 
@@ -132,9 +336,9 @@ public:
 		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Function{}),
 		std::enable_if_t<HasClause>* = nullptr
 		>
-	constexpr decltype(auto) virtual_(Function name) const & {
+	constexpr decltype(auto) virtual_(Function name) const & noexcept {
 		auto clauses = caramel::poly::detail::makeConstexprMap(caramel::poly::detail::clauses(ActualConcept{}));
-		return virtualImpl(clauses[name], name);
+		return virtualImpl(clauses[name], vtable_[name]);
 	}
 
 	template <
@@ -142,9 +346,9 @@ public:
 		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Function{}),
 		std::enable_if_t<HasClause>* = nullptr
 		>
-	constexpr decltype(auto) virtual_(Function name) & {
+	constexpr decltype(auto) virtual_(Function name) & noexcept {
 		auto clauses = caramel::poly::detail::makeConstexprMap(caramel::poly::detail::clauses(ActualConcept{}));
-		return virtualImpl(clauses[name], name);
+		return virtualImpl(clauses[name], vtable_[name]);
 	}
 
 	template <
@@ -152,9 +356,9 @@ public:
 		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Function{}),
 		std::enable_if_t<HasClause>* = nullptr
 		>
-	constexpr decltype(auto) virtual_(Function name) && {
+	constexpr decltype(auto) virtual_(Function name) && noexcept {
 		auto clauses = caramel::poly::detail::makeConstexprMap(caramel::poly::detail::clauses(ActualConcept{}));
-		return virtualImpl(clauses[name], name);
+		return virtualImpl(clauses[name], vtable_[name]);
 	}
 
 	template <
@@ -163,7 +367,9 @@ public:
 		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Function{}),
 		std::enable_if_t<HasClause>* = nullptr
 		>
-	decltype(auto) invoke(Function name, Args&&... args) const & {
+	decltype(auto) invoke(Function name, Args&&... args) const &
+		noexcept(noexcept(virtual_(name)(std::forward<Args>(args)...)))
+	{
 		return virtual_(name)(std::forward<Args>(args)...);
 	}
 
@@ -173,7 +379,9 @@ public:
 		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Function{}),
 		std::enable_if_t<HasClause>* = nullptr
 		>
-	decltype(auto) invoke(Function name, Args&&... args) & {
+	decltype(auto) invoke(Function name, Args&&... args) &
+		noexcept(noexcept(virtual_(name)(std::forward<Args>(args)...)))
+	{
 		return virtual_(name)(std::forward<Args>(args)...);
 	}
 
@@ -183,10 +391,108 @@ public:
 		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Function{}),
 		std::enable_if_t<HasClause>* = nullptr
 		>
-	decltype(auto) invoke(Function name, Args&&... args) && {
+	decltype(auto) invoke(Function name, Args&&... args) &&
+		noexcept(noexcept(virtual_(name)(std::forward<Args>(args)...)))
+	{
 		return virtual_(name)(std::forward<Args>(args)...);
 	}
 
+	// Calls the function `name` like `invoke`, but first checks whether the
+	// object is one of the `Likely` types. If it is, the function is called
+	// directly instead of through the vtable, so that it can be inlined;
+	// otherwise, this is a regular indirect call.
+	//
+	// This is for call sites where a few types are known to be much more
+	// common than the others. Each candidate costs a comparison of the vtable
+	// entry against a constant, so the list should be kept short, and ordered
+	// by decreasing frequency.
+	//
+	// The check compares function pointers, so it works with any vtable
+	// policy. It only recognizes objects stored with the default concept map
+	// of their type; objects stored with a custom concept map are always
+	// dispatched through the vtable.
+	template <
+		class... Likely,
+		class Function,
+		class... Args,
+		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Function{}),
+		std::enable_if_t<HasClause>* = nullptr
+		>
+	decltype(auto) invokeLikely(Function name, Args&&... args) const & {
+		return invokeLikelyImpl(Candidates<Likely...>{}, *this, name, std::forward<Args>(args)...);
+	}
+
+	template <
+		class... Likely,
+		class Function,
+		class... Args,
+		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Function{}),
+		std::enable_if_t<HasClause>* = nullptr
+		>
+	decltype(auto) invokeLikely(Function name, Args&&... args) & {
+		return invokeLikelyImpl(Candidates<Likely...>{}, *this, name, std::forward<Args>(args)...);
+	}
+
+	// Returns a reference to the data member of the object bound to the field
+	// clause `name` (see `caramel::poly::field`). This reads the offset of the
+	// member from the vtable and adds it to the address of the object; no
+	// function is called.
+	template <
+		class Field,
+		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Field{}),
+		std::enable_if_t<HasClause>* = nullptr
+		>
+	decltype(auto) field(Field name) {
+		using T = typename FieldClause<Field>::ValueType;
+		auto* object = static_cast<unsigned char*>(mutableGet()) + vtable_[name];
+		return *reinterpret_cast<T*>(object);
+	}
+
+	template <
+		class Field,
+		bool HasClause = contains(caramel::poly::detail::clauseNames(ActualConcept{}), Field{}),
+		std::enable_if_t<HasClause>* = nullptr
+		>
+	decltype(auto) field(Field name) const {
+		using T = const typename FieldClause<Field>::ValueType;
+		const auto* object = static_cast<const unsigned char*>(constGet()) + vtable_[name];
+		return *reinterpret_cast<T*>(object);
+	}
+
+	// Returns a non-owning view of the object as a poly of `OtherConcept`, if
+	// its type models that concept, and nothing otherwise. Both concepts must
+	// refine `Castable`.
+	//
+	// A type is known to model `OtherConcept` if it is stored somewhere in
+	// the program in a poly of that concept built from its default concept
+	// map; the vtables of such polys are recorded per type when the program
+	// starts. Finding one costs a call through the vtable of this poly and a
+	// lookup in a table of the concepts of the object's type, and the view
+	// refers to the recorded vtable, so its calls go straight to the object's
+	// functions.
+	//
+	// The view refers to the object held by this poly, so it mustn't outlive
+	// it, nor be used after the object is moved.
+	template <class OtherConcept>
+	std::optional<Poly<OtherConcept, caramel::poly::NonOwningStorage>> tryAs() & {
+		using View = Poly<OtherConcept, caramel::poly::NonOwningStorage>;
+		if (const auto* vtable = castVTable<View>()) {
+			return View(std::in_place, typename View::ViewSource{ vtable, mutableGet() });
+		} else {
+			return std::nullopt;
+		}
+	}
+
+	template <class OtherConcept>
+	std::optional<const Poly<OtherConcept, caramel::poly::NonOwningStorage>> tryAs() const & {
+		using View = Poly<OtherConcept, caramel::poly::NonOwningStorage>;
+		if (const auto* vtable = castVTable<View>()) {
+			return View(std::in_place, typename View::ViewSource{ vtable, const_cast<void*>(constGet()) });
+		} else {
+			return std::nullopt;
+		}
+	}
+
 	// Returns a pointer to the underlying storage.
 	//
 	// The pointer is potentially invalidated whenever the poly is modified;
@@ -195,75 +501,261 @@ public:
 	//
 	// The behavior is undefined if the requested type is not cv-qualified `void`
 	// and the underlying storage is not of the requested type.
+	//
+	// If the storage shares the object between polys (e.g. `CowStorage`), the
+	// non-const overload gives this poly its own copy first.
 	template <class T>
 	T* unsafeGet() {
-		return storage_.template get<T>();
+		return mutableGet<T>();
 	}
 
 	template <class T>
 	const T* unsafeGet() const {
-		return storage_.template get<T>();
+		return constGet<T>();
 	}
 
+	// Whether the poly may be moved around with `std::memcpy`. See
+	// `isTriviallyRelocatable`.
+	static constexpr bool TRIVIALLY_RELOCATABLE =
+		caramel::poly::isTriviallyRelocatable<Storage> &&
+		caramel::poly::isTriviallyRelocatable<VTable>;
+
+	// Whether the poly may be copied, which its copy constructor doesn't tell.
+	// See `isCopyConstructible`.
+	static constexpr bool COPY_CONSTRUCTIBLE =
+		contains(caramel::poly::detail::clauseNames(ActualConcept{}), caramel::poly::COPY_CONSTRUCT_LABEL);
+
 private:
 
-	using VTable = typename VTablePolicy::template Type<ActualConcept>;
+	friend struct detail::PolyAccess;
+
+	template <class, class, class>
+	friend struct Poly;
 
 	VTable vtable_;
 
 	Storage storage_;
 
+	// What a view (see `tryAs`) is built from. It is passed as a single
+	// argument so as not to be taken for the arguments of the constructors
+	// storing objects, which check whether their types model the concept.
+	struct ViewSource {
+		const CastVTable* vtable;
+		void* object;
+	};
+
+	Poly(std::in_place_t, ViewSource source) :
+		vtable_{source.vtable},
+		storage_{std::in_place, source.object}
+	{
+	}
+
+	template <class T>
+	static void recordConcept() noexcept {
+		if constexpr (IS_CASTABLE) {
+			using ConceptMap = decltype(caramel::poly::completeConceptMap<ActualConcept, T>(
+				caramel::poly::conceptMap<ActualConcept, T>));
+			(void)detail::CONCEPT_RECORDED<ActualConcept, T, CastVTable, ConceptMap>;
+		}
+	}
+
+	template <class View>
+	const typename View::CastVTable* castVTable() const {
+		static_assert(IS_CASTABLE,
+			"caramel::poly::Poly::tryAs: The concept of the poly must refine Castable.");
+		static_assert(View::IS_CASTABLE,
+			"caramel::poly::Poly::tryAs: The concept to view the poly as must refine Castable.");
+		static_assert(std::is_same_v<typename View::VTable::Table, typename View::CastVTable>);
+		const auto& concepts = *vtable_[caramel::poly::CONCEPTS_LABEL];
+		const auto conceptIndex = detail::ConceptTable::indexOf<typename View::ActualConcept>();
+		return static_cast<const typename View::CastVTable*>(concepts.find(conceptIndex));
+	}
+
+	// Access to the object through which it may be modified. Goes through
+	// the storage's `get(vtable)` where provided (see `PolymorphicStorage`).
+	template <class T = void>
+	T* mutableGet() noexcept(detail::isNothrowMutableGet<Storage, VTable>) {
+		if constexpr (detail::hasMutableGet<Storage, VTable>) {
+			return storage_.template get<T>(vtable_);
+		} else {
+			return storage_.template get<T>();
+		}
+	}
+
+	// Access to the object through which it may only be read. Goes through
+	// the storage's `get(vtable) const` where provided.
+	template <class T = void>
+	const T* constGet() const {
+		if constexpr (detail::hasConstGet<Storage, VTable>) {
+			return storage_.template get<T>(vtable_);
+		} else {
+			return storage_.template get<T>();
+		}
+	}
+
+	// The function that the vtable of a poly holding a `T` has for `name`, if
+	// it was built from the default concept map of `T`.
+	template <class T, class Function>
+	static constexpr auto likelyFunction(Function name) {
+		static_assert(caramel::poly::models<ActualConcept, T>,
+			"caramel::poly::Poly::invokeLikely: A likely type does not model the concept of the poly.");
+		using Signature = typename decltype(ActualConcept{}.getSignature(name))::Type;
+		using ConceptMap = decltype(caramel::poly::completeConceptMap<ActualConcept, T>(
+			caramel::poly::conceptMap<ActualConcept, T>));
+		return detail::EraseFunction<Signature>(ConceptMap{}[name]);
+	}
+
+	template <class Field>
+	struct FieldClause : decltype(ActualConcept{}.getSignature(Field{})) {
+		static_assert(detail::isField<decltype(ActualConcept{}.getSignature(Field{}))>,
+			"caramel::poly::Poly::field: The clause is not a field. Use caramel::poly::field to declare it.");
+	};
+
+	template <class... Likely>
+	struct Candidates {
+	};
+
+	template <class Likely, class... Rest, class Self, class Function, class... Args>
+	static decltype(auto) invokeLikelyImpl(Candidates<Likely, Rest...>, Self& self, Function name, Args&&... args) {
+		constexpr auto function = likelyFunction<Likely>(name);
+		if (self.vtable_[name] == function) {
+			return invokeThrough(self, name, function, std::forward<Args>(args)...);
+		} else {
+			return invokeLikelyImpl(Candidates<Rest...>{}, self, name, std::forward<Args>(args)...);
+		}
+	}
+
+	template <class Self, class Function, class... Args>
+	static decltype(auto) invokeLikelyImpl(Candidates<>, Self& self, Function name, Args&&... args) {
+		return self.invoke(name, std::forward<Args>(args)...);
+	}
+
+	// Whether the functions returned by `virtual_` for functions of the vtable
+	// of type `FunctionPtr` can't throw, given that their arguments can be
+	// passed on without throwing (see `NOTHROW_ARGUMENT`). Getting the object
+	// of a poly whose storage shares it may copy it, which may throw.
+	template <class FunctionPtr>
+	static constexpr bool NOTHROW_CALL =
+		detail::isNoexceptFunction<FunctionPtr> && detail::isNothrowMutableGet<Storage, VTable>;
+
+	// Whether `Arg` can be passed as the parameter `T` of a function of the
+	// vtable without throwing, which it may do when it is converted.
+	template <class T, class Arg>
+	static constexpr bool NOTHROW_ARGUMENT = detail::isPlaceholder<T> || std::is_nothrow_constructible_v<T, Arg>;
+
+	template <class Self, class Function, class FunctionPtr, class... Args>
+	static decltype(auto) invokeThrough(Self& self, Function name, FunctionPtr function, Args&&... args) {
+		auto clauses = caramel::poly::detail::makeConstexprMap(caramel::poly::detail::clauses(ActualConcept{}));
+		return self.virtualImpl(clauses[name], function)(std::forward<Args>(args)...);
+	}
+
+	// Calls `function`, what the vtable holds for the method or function
+	// `name`, with the arguments erased as the function `virtual_` returns
+	// would, but without building that function nor the map of the clauses.
+	// Where little is inlined, as in debug builds, this makes a single call.
+	template <class Self, class Function, class FunctionPtr, class... Args>
+	static decltype(auto) callErased(Self& self, Function name, FunctionPtr function, Args&&... args) {
+		using Clause = decltype(ActualConcept{}.getSignature(name));
+		using Signature = typename Clause::Type*;
+		if constexpr (detail::isMethod<Clause>) {
+			return callMethod(Signature{}, self, function, std::forward<Args>(args)...);
+		} else if constexpr (detail::isBatchMethod<Clause>) {
+			callBatchMethod(Signature{}, self, function, std::forward<Args>(args)...);
+		} else if constexpr (detail::holdsValue<Clause>) {
+			return invokeThrough(self, name, function, std::forward<Args>(args)...);
+		} else {
+			return callFunction(Signature{}, function, std::forward<Args>(args)...);
+		}
+	}
+
+	template <class R, class... T, class FunctionPtr, class... Args>
+	static decltype(auto) callFunction(R (*)(T...), FunctionPtr function, Args&&... args) {
+		return function(Poly::unerasePoly<T>(std::forward<Args>(args))...);
+	}
+
+	template <class R, class SelfT, class... T, class Self, class FunctionPtr, class... Args>
+	static decltype(auto) callMethod(R (*)(SelfT, T...), Self& self, FunctionPtr function, Args&&... args) {
+		return function(Poly::unerasePoly<SelfT>(self), Poly::unerasePoly<T>(std::forward<Args>(args))...);
+	}
+
+	template <class SelfT, class... T, class Self, class FunctionPtr, class... Args>
+	static void callBatchMethod(void (*)(SelfT, std::size_t, T...), Self& self, FunctionPtr function, Args&&... args) {
+		function(Poly::unerasePoly<SelfT>(&self), std::size_t(1), Poly::unerasePoly<T>(std::forward<Args>(args))...);
+	}
+
 	// Handle caramel::poly::function
-	template <class R, class... T, class Name>
-	constexpr decltype(auto) virtualImpl(caramel::poly::Function<R(T...)>, Name name) const {
-		auto fptr = vtable_[name];
-		return [fptr](auto&&... args) -> decltype(auto) {
+	template <class R, class... T, class FunctionPtr>
+	constexpr decltype(auto) virtualImpl(caramel::poly::Function<R(T...)>, FunctionPtr fptr) const {
+		return [fptr](auto&&... args) noexcept(NOTHROW_CALL<FunctionPtr> && (NOTHROW_ARGUMENT<T, decltype(args)> && ...)) -> decltype(auto) {
 			return fptr(Poly::unerasePoly<T>(static_cast<decltype(args)&&>(args))...);
 		};
 	}
 
+	// Handle caramel::poly::constant, whose value is read from the vtable
+	template <class T, class Value>
+	constexpr decltype(auto) virtualImpl(caramel::poly::Constant<T>, Value value) const {
+		return [value]() noexcept(std::is_reference_v<T> || std::is_nothrow_copy_constructible_v<T>) -> T {
+			if constexpr (std::is_reference_v<T>) {
+				return *value;
+			} else {
+				return value;
+			}
+		};
+	}
+
 	// Handle caramel::poly::method
-	template <class R, class... T, class Name>
-	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...)>, Name name) & {
-		auto fptr = vtable_[name];
-		return [fptr, this](auto&&... args) -> decltype(auto) {
+	template <class R, class... T, class FunctionPtr>
+	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...)>, FunctionPtr fptr) & {
+		return [fptr, this](auto&&... args) noexcept(NOTHROW_CALL<FunctionPtr> && (NOTHROW_ARGUMENT<T, decltype(args)> && ...)) -> decltype(auto) {
 			return fptr(Poly::unerasePoly<caramel::poly::SelfPlaceholder&>(*this),
 				Poly::unerasePoly<T>(static_cast<decltype(args)&&>(args))...);
 		};
 	}
-	template <class R, class... T, class Name>
-	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...)&>, Name name) & {
-		auto fptr = vtable_[name];
-		return [fptr, this](auto&&... args) -> decltype(auto) {
+	template <class R, class... T, class FunctionPtr>
+	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...)&>, FunctionPtr fptr) & {
+		return [fptr, this](auto&&... args) noexcept(NOTHROW_CALL<FunctionPtr> && (NOTHROW_ARGUMENT<T, decltype(args)> && ...)) -> decltype(auto) {
 			return fptr(Poly::unerasePoly<caramel::poly::SelfPlaceholder&>(*this),
 				Poly::unerasePoly<T>(static_cast<decltype(args)&&>(args))...);
 		};
 	}
-	template <class R, class... T, class Name>
-	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...)&&>, Name name) && {
-		auto fptr = vtable_[name];
-		return [fptr, this](auto&&... args) -> decltype(auto) {
+	template <class R, class... T, class FunctionPtr>
+	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...)&&>, FunctionPtr fptr) && {
+		return [fptr, this](auto&&... args) noexcept(NOTHROW_CALL<FunctionPtr> && (NOTHROW_ARGUMENT<T, decltype(args)> && ...)) -> decltype(auto) {
 			return fptr(Poly::unerasePoly<caramel::poly::SelfPlaceholder&&>(*this),
 				Poly::unerasePoly<T>(static_cast<decltype(args)&&>(args))...);
 		};
 	}
-	template <class R, class... T, class Name>
-	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...) const>, Name name) const {
-		auto fptr = vtable_[name];
-		return [fptr, this](auto&&... args) -> decltype(auto) {
+	template <class R, class... T, class FunctionPtr>
+	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...) const>, FunctionPtr fptr) const {
+		return [fptr, this](auto&&... args) noexcept(NOTHROW_CALL<FunctionPtr> && (NOTHROW_ARGUMENT<T, decltype(args)> && ...)) -> decltype(auto) {
 			return fptr(Poly::unerasePoly<caramel::poly::SelfPlaceholder const&>(*this),
 				Poly::unerasePoly<T>(static_cast<decltype(args)&&>(args))...);
 		};
 	}
-	template <class R, class... T, class Name>
-	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...) const&>, Name name) const {
-		auto fptr = vtable_[name];
-		return [fptr, this](auto&&... args) -> decltype(auto) {
+	template <class R, class... T, class FunctionPtr>
+	constexpr decltype(auto) virtualImpl(caramel::poly::Method<R(T...) const&>, FunctionPtr fptr) const {
+		return [fptr, this](auto&&... args) noexcept(NOTHROW_CALL<FunctionPtr> && (NOTHROW_ARGUMENT<T, decltype(args)> && ...)) -> decltype(auto) {
 			return fptr(Poly::unerasePoly<caramel::poly::SelfPlaceholder const&>(*this),
 				Poly::unerasePoly<T>(static_cast<decltype(args)&&>(args))...);
 		};
 	}
 
+	// Handle caramel::poly::batchMethod, called on this object alone
+	template <class... T, class FunctionPtr>
+	constexpr decltype(auto) virtualImpl(caramel::poly::BatchMethod<void (T...)>, FunctionPtr fptr) & {
+		return [fptr, this](auto&&... args) {
+			fptr(Poly::unerasePoly<caramel::poly::SelfPlaceholder*>(this), std::size_t(1),
+				Poly::unerasePoly<T>(static_cast<decltype(args)&&>(args))...);
+		};
+	}
+	template <class... T, class FunctionPtr>
+	constexpr decltype(auto) virtualImpl(caramel::poly::BatchMethod<void (T...) const>, FunctionPtr fptr) const {
+		return [fptr, this](auto&&... args) {
+			fptr(Poly::unerasePoly<const caramel::poly::SelfPlaceholder*>(this), std::size_t(1),
+				Poly::unerasePoly<T>(static_cast<decltype(args)&&>(args))...);
+		};
+	}
+
 	// unerasePoly helper
 	template <class T, class Arg, std::enable_if_t<!detail::isPlaceholder<T>, int> = 0>
 	static constexpr decltype(auto) unerasePoly(Arg&& arg) {
@@ -277,7 +769,11 @@ private:
 		static_assert(isPoly,
 			"caramel::poly::Poly::virtual_: Passing a non-poly object as an argument to a virtual "
 			"function that specified a placeholder for that parameter.");
-		return static_cast<Arg&&>(arg).storage_.get();
+		if constexpr (detail::isConstPlaceholder<T> || std::is_const_v<std::remove_reference_t<Arg>>) {
+			return std::as_const(arg).constGet();
+		} else {
+			return arg.mutableGet();
+		}
 	}
 
 	template <class T, class Arg, std::enable_if_t<detail::isPlaceholder<T>, int> = 0>
@@ -287,10 +783,43 @@ private:
 		static_assert(isPoly,
 			"caramel::poly::Poly::virtual_: Passing a non-poly object as an argument to a virtual "
 			"function that specified a placeholder for that parameter.");
-		return arg->storage_.get();
+		if constexpr (detail::isConstPlaceholder<T> || std::is_const_v<Arg>) {
+			return std::as_const(*arg).constGet();
+		} else {
+			return arg->mutableGet();
+		}
 	}
 };
 
+namespace detail {
+
+template <class Concept, class OtherConcept, class Storage, class VTablePolicy, class OtherVTablePolicy>
+constexpr bool isRefinedPoly<Poly<Concept, Storage, VTablePolicy>, Poly<OtherConcept, Storage, OtherVTablePolicy>> =
+	!std::is_same_v<Poly<Concept, Storage, VTablePolicy>, Poly<OtherConcept, Storage, OtherVTablePolicy>> &&
+	hasClausesOf(
+		PolyAccess::Concept<Poly<OtherConcept, Storage, OtherVTablePolicy>>{},
+		PolyAccess::Concept<Poly<Concept, Storage, VTablePolicy>>{}
+		);
+
+template <class Concept, class OtherConcept, class Storage, class VTablePolicy, class OtherVTablePolicy>
+constexpr bool isUpcastable<Poly<Concept, Storage, VTablePolicy>, Poly<OtherConcept, Storage, OtherVTablePolicy>> =
+	isRefinedPoly<Poly<Concept, Storage, VTablePolicy>, Poly<OtherConcept, Storage, OtherVTablePolicy>> &&
+	std::is_constructible_v<
+		PolyAccess::VTable<Poly<Concept, Storage, VTablePolicy>>,
+		SliceTag,
+		const PolyAccess::VTable<Poly<OtherConcept, Storage, OtherVTablePolicy>>&
+		>;
+
+} // namespace detail
+
+template <class Concept, class Storage, class VTablePolicy>
+constexpr bool isTriviallyRelocatable<Poly<Concept, Storage, VTablePolicy>> =
+	Poly<Concept, Storage, VTablePolicy>::TRIVIALLY_RELOCATABLE;
+
+template <class Concept, class Storage, class VTablePolicy>
+constexpr bool isCopyConstructible<Poly<Concept, Storage, VTablePolicy>> =
+	Poly<Concept, Storage, VTablePolicy>::COPY_CONSTRUCTIBLE;
+
 } // end namespace caramel::poly
 
 #endif /* CARAMELPOLY_POLY_HPP__ */
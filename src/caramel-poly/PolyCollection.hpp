@@ -0,0 +1,343 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_POLYCOLLECTION_HPP__
+#define CARAMELPOLY_POLYCOLLECTION_HPP__
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/isPlaceholder.hpp"
+#include "builtin.hpp"
+#include "Concept.hpp"
+#include "ConceptMap.hpp"
+#include "relocation.hpp"
+#include "storage.hpp"
+#include "vtable.hpp"
+
+namespace caramel::poly {
+
+namespace detail {
+
+// An object whose address uniquely identifies the type `T`. It isn't a
+// constant, so that linkers folding identical constants (like MSVC with
+// `/OPT:ICF`) keep the keys of different types apart.
+template <class T>
+inline char TYPE_KEY = 0;
+
+} // namespace detail
+
+// A container of objects of different types modelling `Concept`, with every
+// type kept in its own contiguous segment.
+//
+// Where a `std::vector<Poly<Concept>>` holds a vtable next to every element
+// (and, with remote storage, a pointer to the element elsewhere on the heap),
+// a `PolyCollection` holds one vtable per segment, and the elements of each
+// segment are laid out as in a `T[]`. `invoke` then looks the function up
+// once per segment and calls it on every element in a tight loop, so the
+// indirect calls always go to the same place and the elements are visited
+// in memory order.
+//
+// Elements are visited segment by segment, in the order in which the types
+// were first inserted; the order of insertion of elements of different types
+// is not preserved. Inserting an element may move the other elements of its
+// segment, invalidating references to them.
+template <class Concept>
+class PolyCollection {
+private:
+
+	using ActualConcept = decltype(caramel::poly::requires(
+		Concept{},
+		caramel::poly::Destructible{},
+		caramel::poly::Relocatable{}
+		));
+
+	using VTable = typename caramel::poly::VTable<caramel::poly::Local<caramel::poly::Everything>>::template Type<ActualConcept>;
+
+public:
+
+	PolyCollection() = default;
+
+	PolyCollection(const PolyCollection&) = delete;
+	PolyCollection& operator=(const PolyCollection&) = delete;
+
+	PolyCollection(PolyCollection&& other) noexcept :
+		segments_{std::move(other.segments_)},
+		size_{std::exchange(other.size_, 0)}
+	{
+	}
+
+	PolyCollection& operator=(PolyCollection&& other) noexcept {
+		PolyCollection(std::move(other)).swap(*this);
+		return *this;
+	}
+
+	~PolyCollection() {
+		for (auto& segment : segments_) {
+			destroyElements(segment);
+			deallocate(segment.data, segment.alignment);
+		}
+	}
+
+	void swap(PolyCollection& other) noexcept {
+		using std::swap;
+		swap(segments_, other.segments_);
+		swap(size_, other.size_);
+	}
+
+	friend void swap(PolyCollection& a, PolyCollection& b) noexcept {
+		a.swap(b);
+	}
+
+	// Constructs an object of type `T` at the end of its segment.
+	template <class T, class... Args>
+	T& emplace(Args&&... args) {
+		static_assert(caramel::poly::models<ActualConcept, T>,
+			"caramel::poly::PolyCollection::emplace: The type does not model the concept of the "
+			"collection.");
+		static_assert(caramel::poly::isTriviallyRelocatable<T> || std::is_nothrow_move_constructible_v<T>,
+			"caramel::poly::PolyCollection::emplace: Elements are moved around when their segment "
+			"grows, so they must be nothrow move constructible.");
+
+		auto& segment = segmentFor<T>();
+		T* element;
+		if (segment.size == segment.capacity) {
+			// `args` may refer to an element of this segment, so the new element is
+			// constructed before the old ones are moved out of the way.
+			const auto capacity = segment.capacity == 0 ? INITIAL_CAPACITY : 2 * segment.capacity;
+			auto* data = allocate(segment, capacity);
+			try {
+				element = new (data + segment.size * sizeof(T)) T(std::forward<Args>(args)...);
+			} catch (...) {
+				deallocate(data, segment.alignment);
+				throw;
+			}
+			moveTo(segment, data, capacity);
+		} else {
+			element = new (segment.data + segment.size * sizeof(T)) T(std::forward<Args>(args)...);
+		}
+
+		++segment.size;
+		++size_;
+		return *element;
+	}
+
+	template <class T>
+	std::decay_t<T>& insert(T&& t) {
+		return emplace<std::decay_t<T>>(std::forward<T>(t));
+	}
+
+	// Calls the function `name` on every element, passing it `args`. The
+	// function must take the object as its first parameter, and no other
+	// placeholders. Since the same arguments are passed to every element,
+	// they are passed as lvalues.
+	//
+	// A `batchMethod` is called once per segment, with the whole array.
+	template <class Function, class... Args>
+	void invoke(Function name, Args&&... args) {
+		checkInvocable(name);
+		for (auto& segment : segments_) {
+			const auto function = segment.vtable[name];
+			if constexpr (IS_BATCH_METHOD<Function>) {
+				function(static_cast<void*>(segment.data), segment.size, args...);
+			} else {
+				const auto stride = segment.elementSize;
+				auto* const end = segment.data + segment.size * stride;
+				for (auto* element = segment.data; element != end; element += stride) {
+					function(static_cast<void*>(element), args...);
+				}
+			}
+		}
+	}
+
+	template <class Function, class... Args>
+	void invoke(Function name, Args&&... args) const {
+		checkInvocable(name);
+		for (const auto& segment : segments_) {
+			const auto function = segment.vtable[name];
+			if constexpr (IS_BATCH_METHOD<Function>) {
+				function(static_cast<const void*>(segment.data), segment.size, args...);
+			} else {
+				const auto stride = segment.elementSize;
+				const unsigned char* const end = segment.data + segment.size * stride;
+				for (const unsigned char* element = segment.data; element != end; element += stride) {
+					function(static_cast<const void*>(element), args...);
+				}
+			}
+		}
+	}
+
+	// Calls `f` on every element of type `T`, without any dynamic dispatch.
+	template <class T, class F>
+	void forEach(F&& f) {
+		if (auto* segment = findSegment<T>()) {
+			auto* elements = reinterpret_cast<T*>(segment->data);
+			for (auto i = std::size_t(0); i != segment->size; ++i) {
+				f(elements[i]);
+			}
+		}
+	}
+
+	template <class T, class F>
+	void forEach(F&& f) const {
+		if (const auto* segment = findSegment<T>()) {
+			const auto* elements = reinterpret_cast<const T*>(segment->data);
+			for (auto i = std::size_t(0); i != segment->size; ++i) {
+				f(elements[i]);
+			}
+		}
+	}
+
+	// Destroys all the elements, keeping the memory of the segments.
+	void clear() noexcept {
+		for (auto& segment : segments_) {
+			destroyElements(segment);
+			segment.size = 0;
+		}
+		size_ = 0;
+	}
+
+	std::size_t size() const noexcept {
+		return size_;
+	}
+
+	template <class T>
+	std::size_t size() const noexcept {
+		const auto* segment = findSegment<T>();
+		return segment == nullptr ? 0 : segment->size;
+	}
+
+	bool empty() const noexcept {
+		return size_ == 0;
+	}
+
+	// The number of distinct types inserted so far.
+	std::size_t segmentCount() const noexcept {
+		return segments_.size();
+	}
+
+private:
+
+	struct Segment {
+
+		const void* type;
+
+		VTable vtable;
+
+		std::size_t elementSize;
+
+		std::size_t alignment;
+
+		bool triviallyRelocatable;
+
+		bool triviallyDestructible;
+
+		unsigned char* data;
+
+		std::size_t size;
+
+		std::size_t capacity;
+
+	};
+
+	static constexpr std::size_t INITIAL_CAPACITY = 8;
+
+	template <class Function>
+	static constexpr bool IS_BATCH_METHOD =
+		detail::isBatchMethod<decltype(ActualConcept{}.getSignature(Function{}))>;
+
+	std::vector<Segment> segments_;
+
+	std::size_t size_ = 0;
+
+	template <class Function>
+	static constexpr void checkInvocable(Function name) {
+		using Signature = typename decltype(ActualConcept{}.getSignature(name))::Type;
+		static_assert(detail::takesOnlySelf<Signature>,
+			"caramel::poly::PolyCollection::invoke: The function must take the object as its first "
+			"parameter, and no other placeholders.");
+	}
+
+	// Segments are looked up linearly; the number of types in a collection is
+	// expected to be small, and the lookup only happens on insertion.
+	template <class T>
+	Segment* findSegment() noexcept {
+		for (auto& segment : segments_) {
+			if (segment.type == &detail::TYPE_KEY<T>) {
+				return &segment;
+			}
+		}
+		return nullptr;
+	}
+
+	template <class T>
+	const Segment* findSegment() const noexcept {
+		return const_cast<PolyCollection&>(*this).template findSegment<T>();
+	}
+
+	template <class T>
+	Segment& segmentFor() {
+		if (auto* segment = findSegment<T>()) {
+			return *segment;
+		}
+
+		return segments_.emplace_back(Segment{
+			&detail::TYPE_KEY<T>,
+			VTable{caramel::poly::completeConceptMap<ActualConcept, T>(caramel::poly::conceptMap<ActualConcept, T>)},
+			sizeof(T),
+			alignof(T),
+			caramel::poly::isTriviallyRelocatable<T>,
+			std::is_trivially_destructible_v<T>,
+			nullptr,
+			0,
+			0
+			});
+	}
+
+	static unsigned char* allocate(const Segment& segment, std::size_t capacity) {
+		return static_cast<unsigned char*>(
+			::operator new(capacity * segment.elementSize, std::align_val_t{ segment.alignment }));
+	}
+
+	// Relocates the elements of `segment` to `data` and frees the old buffer.
+	static void moveTo(Segment& segment, unsigned char* data, std::size_t capacity) noexcept {
+		if (segment.triviallyRelocatable) {
+			if (segment.size != 0) {
+				std::memcpy(data, segment.data, segment.size * segment.elementSize);
+			}
+		} else {
+			for (auto i = std::size_t(0); i != segment.size; ++i) {
+				const auto offset = i * segment.elementSize;
+				detail::relocate(segment.vtable, data + offset, segment.data + offset);
+			}
+		}
+
+		deallocate(segment.data, segment.alignment);
+		segment.data = data;
+		segment.capacity = capacity;
+	}
+
+	static void destroyElements(Segment& segment) noexcept {
+		if (!segment.triviallyDestructible) {
+			const auto destruct = segment.vtable[DESTRUCT_LABEL];
+			for (auto i = std::size_t(0); i != segment.size; ++i) {
+				destruct(segment.data + i * segment.elementSize);
+			}
+		}
+	}
+
+	static void deallocate(unsigned char* data, std::size_t alignment) noexcept {
+		if (data != nullptr) {
+			::operator delete(data, std::align_val_t{ alignment });
+		}
+	}
+
+};
+
+} // namespace caramel::poly
+
+#endif /* CARAMELPOLY_POLYCOLLECTION_HPP__ */
@@ -0,0 +1,319 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_POLYSEQUENCE_HPP__
+#define CARAMELPOLY_POLYSEQUENCE_HPP__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "detail/isPlaceholder.hpp"
+#include "builtin.hpp"
+#include "Concept.hpp"
+#include "ConceptMap.hpp"
+#include "relocation.hpp"
+#include "storage.hpp"
+#include "vtable.hpp"
+
+namespace caramel::poly {
+
+// A sequence of objects of different types modelling `Concept`, packed back to
+// back in a single growable byte buffer, in insertion order.
+//
+// Every object is preceded by a small header holding its vtable (as specified
+// by `VTablePolicy`, so just a pointer by default) and the offsets of the
+// object and of the next header. Walking the sequence thus reads the buffer
+// linearly, and inserting an object doesn't allocate unless the buffer has to
+// grow. When it does, the buffer is copied with `std::memcpy` if all the
+// objects in it are trivially relocatable, and the objects are relocated
+// through their vtables otherwise.
+//
+// This is meant for things like command buffers and event logs, where the
+// order of the objects matters. When it doesn't, `PolyCollection` groups the
+// objects by type, which makes dispatch cheaper.
+//
+// Objects may not be more strictly aligned than `std::max_align_t`. Inserting
+// an object may move the others, invalidating references to them.
+template <
+	class Concept,
+	class VTablePolicy = caramel::poly::VTable<caramel::poly::Remote<caramel::poly::Everything>>
+	>
+class PolySequence {
+private:
+
+	using ActualConcept = decltype(caramel::poly::requires(
+		Concept{},
+		caramel::poly::Destructible{},
+		caramel::poly::Relocatable{}
+		));
+
+	using VTable = typename VTablePolicy::template Type<ActualConcept>;
+
+	struct Header {
+
+		VTable vtable;
+
+		// Offset of the object from the start of the header.
+		std::uint32_t object;
+
+		// Offset of the next header from the start of this one.
+		std::uint32_t next;
+
+	};
+
+public:
+
+	static constexpr std::size_t MAX_ALIGNMENT = alignof(std::max_align_t);
+
+	PolySequence() = default;
+
+	PolySequence(const PolySequence&) = delete;
+	PolySequence& operator=(const PolySequence&) = delete;
+
+	PolySequence(PolySequence&& other) noexcept :
+		data_{std::exchange(other.data_, nullptr)},
+		bytes_{std::exchange(other.bytes_, 0)},
+		capacity_{std::exchange(other.capacity_, 0)},
+		size_{std::exchange(other.size_, 0)},
+		triviallyRelocatable_{std::exchange(other.triviallyRelocatable_, true)},
+		triviallyDestructible_{std::exchange(other.triviallyDestructible_, true)}
+	{
+	}
+
+	PolySequence& operator=(PolySequence&& other) noexcept {
+		PolySequence(std::move(other)).swap(*this);
+		return *this;
+	}
+
+	~PolySequence() {
+		clear();
+		::operator delete(data_);
+	}
+
+	void swap(PolySequence& other) noexcept {
+		using std::swap;
+		swap(data_, other.data_);
+		swap(bytes_, other.bytes_);
+		swap(capacity_, other.capacity_);
+		swap(size_, other.size_);
+		swap(triviallyRelocatable_, other.triviallyRelocatable_);
+		swap(triviallyDestructible_, other.triviallyDestructible_);
+	}
+
+	friend void swap(PolySequence& a, PolySequence& b) noexcept {
+		a.swap(b);
+	}
+
+	// Constructs an object of type `T` at the end of the sequence.
+	template <class T, class... Args>
+	T& emplaceBack(Args&&... args) {
+		static_assert(caramel::poly::models<ActualConcept, T>,
+			"caramel::poly::PolySequence::emplaceBack: The type does not model the concept of the "
+			"sequence.");
+		static_assert(alignof(T) <= MAX_ALIGNMENT,
+			"caramel::poly::PolySequence::emplaceBack: Over-aligned types are not supported.");
+		static_assert(caramel::poly::isTriviallyRelocatable<T> || std::is_nothrow_move_constructible_v<T>,
+			"caramel::poly::PolySequence::emplaceBack: Objects are moved around when the buffer "
+			"grows, so they must be nothrow move constructible.");
+
+		const auto header = bytes_;
+		const auto object = alignUp(header + sizeof(Header), alignof(T));
+		const auto next = alignUp(object + sizeof(T), alignof(Header));
+		assert(next - header <= std::numeric_limits<std::uint32_t>::max() &&
+			"caramel::poly::PolySequence::emplaceBack: The object is too large");
+
+		T* result;
+		if (next > capacity_) {
+			// `args` may refer to an object in this sequence, so the new object is
+			// constructed before the old ones are moved out of the way.
+			const auto capacity = std::max({ next, 2 * capacity_, INITIAL_CAPACITY });
+			auto* data = static_cast<unsigned char*>(::operator new(capacity));
+			try {
+				result = new (data + object) T(std::forward<Args>(args)...);
+			} catch (...) {
+				::operator delete(data);
+				throw;
+			}
+			moveTo(data, capacity);
+		} else {
+			result = new (data_ + object) T(std::forward<Args>(args)...);
+		}
+
+		new (data_ + header) Header{
+			VTable{caramel::poly::completeConceptMap<ActualConcept, T>(caramel::poly::conceptMap<ActualConcept, T>)},
+			static_cast<std::uint32_t>(object - header),
+			static_cast<std::uint32_t>(next - header)
+			};
+
+		bytes_ = next;
+		++size_;
+		triviallyRelocatable_ = triviallyRelocatable_ && caramel::poly::isTriviallyRelocatable<T>;
+		triviallyDestructible_ = triviallyDestructible_ && std::is_trivially_destructible_v<T>;
+		return *result;
+	}
+
+	template <class T>
+	std::decay_t<T>& pushBack(T&& t) {
+		return emplaceBack<std::decay_t<T>>(std::forward<T>(t));
+	}
+
+	// Calls the function `name` on every object, in insertion order, passing
+	// it `args`. The function must take the object as its first parameter, and
+	// no other placeholders. Since the same arguments are passed to every
+	// object, they are passed as lvalues. A `batchMethod` is called on one
+	// object at a time.
+	//
+	// The position of the next object is read before calling the function, so
+	// that finding it doesn't have to wait for the call to return.
+	template <class Function, class... Args>
+	void invoke(Function name, Args&&... args) {
+		checkInvocable(name);
+		auto* const end = data_ + bytes_;
+		for (auto* position = data_; position != end;) {
+			const auto& header = *reinterpret_cast<const Header*>(position);
+			const auto next = header.next;
+			if constexpr (IS_BATCH_METHOD<Function>) {
+				header.vtable[name](static_cast<void*>(position + header.object), std::size_t(1), args...);
+			} else {
+				header.vtable[name](static_cast<void*>(position + header.object), args...);
+			}
+			position += next;
+		}
+	}
+
+	template <class Function, class... Args>
+	void invoke(Function name, Args&&... args) const {
+		checkInvocable(name);
+		const unsigned char* const end = data_ + bytes_;
+		for (const unsigned char* position = data_; position != end;) {
+			const auto& header = *reinterpret_cast<const Header*>(position);
+			const auto next = header.next;
+			if constexpr (IS_BATCH_METHOD<Function>) {
+				header.vtable[name](static_cast<const void*>(position + header.object), std::size_t(1), args...);
+			} else {
+				header.vtable[name](static_cast<const void*>(position + header.object), args...);
+			}
+			position += next;
+		}
+	}
+
+	// Makes room for objects taking `bytes` bytes in total, headers included.
+	void reserve(std::size_t bytes) {
+		if (bytes <= capacity_) {
+			return;
+		}
+
+		const auto capacity = std::max({ bytes, 2 * capacity_, INITIAL_CAPACITY });
+		moveTo(static_cast<unsigned char*>(::operator new(capacity)), capacity);
+	}
+
+	// Destroys all the objects, keeping the buffer.
+	void clear() noexcept {
+		if (!triviallyDestructible_) {
+			for (auto offset = std::size_t(0); offset != bytes_;) {
+				const auto* header = headerAt(offset);
+				header->vtable[DESTRUCT_LABEL](data_ + offset + header->object);
+				offset += header->next;
+			}
+		}
+
+		bytes_ = 0;
+		size_ = 0;
+		triviallyRelocatable_ = true;
+		triviallyDestructible_ = true;
+	}
+
+	// The number of objects in the sequence.
+	std::size_t size() const noexcept {
+		return size_;
+	}
+
+	bool empty() const noexcept {
+		return size_ == 0;
+	}
+
+	// The number of bytes taken by the objects and their headers.
+	std::size_t byteSize() const noexcept {
+		return bytes_;
+	}
+
+	std::size_t capacity() const noexcept {
+		return capacity_;
+	}
+
+private:
+
+	static_assert(std::is_trivially_copyable_v<Header>,
+		"caramel::poly::PolySequence: The headers are copied bytewise, so the vtable must be "
+		"trivially copyable.");
+
+	static constexpr std::size_t INITIAL_CAPACITY = 256;
+
+	template <class Function>
+	static constexpr bool IS_BATCH_METHOD =
+		detail::isBatchMethod<decltype(ActualConcept{}.getSignature(Function{}))>;
+
+	unsigned char* data_ = nullptr;
+
+	std::size_t bytes_ = 0;
+
+	std::size_t capacity_ = 0;
+
+	std::size_t size_ = 0;
+
+	bool triviallyRelocatable_ = true;
+
+	bool triviallyDestructible_ = true;
+
+	static constexpr std::size_t alignUp(std::size_t offset, std::size_t alignment) noexcept {
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+
+	template <class Function>
+	static constexpr void checkInvocable(Function name) {
+		using Signature = typename decltype(ActualConcept{}.getSignature(name))::Type;
+		static_assert(detail::takesOnlySelf<Signature>,
+			"caramel::poly::PolySequence::invoke: The function must take the object as its first "
+			"parameter, and no other placeholders.");
+	}
+
+	Header* headerAt(std::size_t offset) noexcept {
+		return reinterpret_cast<Header*>(data_ + offset);
+	}
+
+	const Header* headerAt(std::size_t offset) const noexcept {
+		return reinterpret_cast<const Header*>(data_ + offset);
+	}
+
+	// Relocates the objects to `data` and frees the old buffer.
+	void moveTo(unsigned char* data, std::size_t capacity) noexcept {
+		if (triviallyRelocatable_) {
+			if (bytes_ != 0) {
+				std::memcpy(data, data_, bytes_);
+			}
+		} else {
+			for (auto offset = std::size_t(0); offset != bytes_;) {
+				const auto* header = headerAt(offset);
+				std::memcpy(data + offset, header, sizeof(Header));
+				detail::relocate(header->vtable, data + offset + header->object, data_ + offset + header->object);
+				offset += header->next;
+			}
+		}
+
+		::operator delete(data_);
+		data_ = data;
+		capacity_ = capacity;
+	}
+
+};
+
+} // namespace caramel::poly
+
+#endif /* CARAMELPOLY_POLYSEQUENCE_HPP__ */
@@ -0,0 +1,270 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_POOLALLOCATOR_HPP__
+#define CARAMELPOLY_POOLALLOCATOR_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace caramel::poly {
+
+// Allocator policy serving small blocks from fixed size classes.
+//
+// This is a drop-in replacement for `MallocAllocator` in the `Allocator`
+// parameter of the storage classes, meant for programs that create and destroy
+// many short-lived heap-spilled objects. Requests are rounded up to a multiple
+// of `alignof(std::max_align_t)` and served from per-thread free lists, so the
+// common allocate/free pair touches no lock and no atomic. Requests larger than
+// `MAX_BLOCK_SIZE` are forwarded to `std::malloc`.
+//
+// Every block remembers the thread cache that carved it. A block freed by
+// another thread is pushed onto a lock-free list owned by that cache, which
+// the owner drains the next time its local free list for that size class runs
+// dry. When a thread exits, its cache is parked on a global list and adopted
+// by the next thread that needs one, so blocks freed after the owner is gone
+// are not lost.
+//
+// Memory is obtained from `std::malloc` in chunks of `CHUNK_SIZE` bytes and
+// is retained by the pool for the lifetime of the program.
+//
+// Like `MallocAllocator`, the returned memory is suitably aligned for any type
+// whose alignment does not exceed `alignof(std::max_align_t)`.
+template <std::size_t MAX_BLOCK_SIZE = 256, std::size_t CHUNK_SIZE = 16 * 1024>
+struct PoolAllocator {
+private:
+
+	static constexpr std::size_t GRANULARITY = alignof(std::max_align_t);
+
+public:
+
+	static_assert(MAX_BLOCK_SIZE > 0 && MAX_BLOCK_SIZE % GRANULARITY == 0,
+		"caramel::poly::PoolAllocator: MAX_BLOCK_SIZE must be a non-zero multiple of "
+		"alignof(std::max_align_t)");
+	static_assert(CHUNK_SIZE >= 2 * (MAX_BLOCK_SIZE + GRANULARITY),
+		"caramel::poly::PoolAllocator: CHUNK_SIZE must fit at least two of the largest blocks");
+
+	static void* allocate(std::size_t size) {
+		if (size > MAX_BLOCK_SIZE) {
+			return allocateUnpooled(size);
+		}
+
+		auto* cache = threadCache();
+		if (cache == nullptr) {
+			// The thread is exiting and has already given its cache away.
+			return allocateUnpooled(size);
+		}
+
+		const auto sizeClass = sizeClassOf(size);
+		auto*& head = cache->local[sizeClass];
+		if (head == nullptr) {
+			head = cache->remote[sizeClass].exchange(nullptr, std::memory_order_acquire);
+			if (head == nullptr) {
+				head = refill(cache, sizeClass);
+				if (head == nullptr) {
+					return nullptr;
+				}
+			}
+		}
+
+		auto* block = head;
+		head = block->next;
+		return block;
+	}
+
+	static void free(void* ptr) {
+		if (ptr == nullptr) {
+			return;
+		}
+
+		auto* header = static_cast<Header*>(ptr) - 1;
+		if (header->sizeClass == UNPOOLED) {
+			std::free(header);
+			return;
+		}
+
+		auto* block = static_cast<FreeBlock*>(ptr);
+		auto* owner = header->owner;
+		const auto sizeClass = header->sizeClass;
+
+		if (owner == currentCache()) {
+			block->next = owner->local[sizeClass];
+			owner->local[sizeClass] = block;
+		} else {
+			auto& remote = owner->remote[sizeClass];
+			block->next = remote.load(std::memory_order_relaxed);
+			while (!remote.compare_exchange_weak(
+				block->next, block, std::memory_order_release, std::memory_order_relaxed))
+			{
+			}
+		}
+	}
+
+	// Standard allocator adapter over the pool, used to place the control block
+	// and the object of `makeShared` in a single pooled allocation.
+	template <class T>
+	struct StdAllocator {
+		using value_type = T;
+
+		StdAllocator() = default;
+
+		template <class U>
+		StdAllocator(const StdAllocator<U>&) noexcept {
+		}
+
+		T* allocate(std::size_t n) {
+			auto* ptr = PoolAllocator::allocate(n * sizeof(T));
+			if (ptr == nullptr) {
+				throw std::bad_alloc();
+			}
+			return static_cast<T*>(ptr);
+		}
+
+		void deallocate(T* ptr, std::size_t) noexcept {
+			PoolAllocator::free(ptr);
+		}
+
+		template <class U>
+		friend bool operator==(const StdAllocator&, const StdAllocator<U>&) noexcept {
+			return true;
+		}
+
+		template <class U>
+		friend bool operator!=(const StdAllocator&, const StdAllocator<U>&) noexcept {
+			return false;
+		}
+	};
+
+	template <class T, class... Args>
+	static std::shared_ptr<T> makeShared(Args&&... args) {
+		return std::allocate_shared<T>(StdAllocator<T>{}, std::forward<Args>(args)...);
+	}
+
+private:
+
+	static constexpr std::size_t SIZE_CLASS_COUNT = MAX_BLOCK_SIZE / GRANULARITY;
+	static constexpr std::size_t UNPOOLED = SIZE_CLASS_COUNT;
+
+	struct ThreadCache;
+
+	// Placed in front of every block. Its size keeps the block itself aligned
+	// to `GRANULARITY`.
+	struct alignas(std::max_align_t) Header {
+		ThreadCache* owner;
+		std::size_t sizeClass;
+	};
+
+	// Overlays the payload of a block while it sits on a free list.
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	struct ThreadCache {
+		FreeBlock* local[SIZE_CLASS_COUNT] = {};
+		std::atomic<FreeBlock*> remote[SIZE_CLASS_COUNT] = {};
+		ThreadCache* nextOrphan = nullptr;
+	};
+
+	// Hands the cache of an exiting thread over to the orphan list.
+	struct CacheGuard {
+		CacheGuard() {
+			currentCache() = adoptOrCreateCache();
+		}
+
+		~CacheGuard() {
+			auto* cache = currentCache();
+			currentCache() = nullptr;
+			threadExiting() = true;
+
+			if (cache != nullptr) {
+				std::lock_guard<std::mutex> lock(orphansMutex_);
+				cache->nextOrphan = orphans_;
+				orphans_ = cache;
+			}
+		}
+	};
+
+	static inline std::mutex orphansMutex_;
+
+	static inline ThreadCache* orphans_ = nullptr;
+
+	static constexpr std::size_t sizeClassOf(std::size_t size) {
+		return size == 0 ? 0 : (size - 1) / GRANULARITY;
+	}
+
+	static constexpr std::size_t blockSize(std::size_t sizeClass) {
+		return sizeof(Header) + (sizeClass + 1) * GRANULARITY;
+	}
+
+	// Both are trivially destructible, so they stay usable while other
+	// thread-local objects are being destroyed.
+	static ThreadCache*& currentCache() {
+		static thread_local ThreadCache* cache = nullptr;
+		return cache;
+	}
+
+	static bool& threadExiting() {
+		static thread_local bool exiting = false;
+		return exiting;
+	}
+
+	static ThreadCache* threadCache() {
+		if (currentCache() == nullptr && !threadExiting()) {
+			static thread_local CacheGuard guard;
+		}
+		return currentCache();
+	}
+
+	static ThreadCache* adoptOrCreateCache() {
+		{
+			std::lock_guard<std::mutex> lock(orphansMutex_);
+			if (orphans_ != nullptr) {
+				auto* cache = orphans_;
+				orphans_ = cache->nextOrphan;
+				cache->nextOrphan = nullptr;
+				return cache;
+			}
+		}
+
+		return new ThreadCache();
+	}
+
+	static FreeBlock* refill(ThreadCache* cache, std::size_t sizeClass) {
+		auto* chunk = static_cast<unsigned char*>(std::malloc(CHUNK_SIZE));
+		if (chunk == nullptr) {
+			return nullptr;
+		}
+
+		const auto stride = blockSize(sizeClass);
+		const auto count = CHUNK_SIZE / stride;
+
+		FreeBlock* head = nullptr;
+		for (auto i = count; i != 0; --i) {
+			auto* header = new (chunk + (i - 1) * stride) Header{ cache, sizeClass };
+			auto* block = new (header + 1) FreeBlock{ head };
+			head = block;
+		}
+
+		return head;
+	}
+
+	static void* allocateUnpooled(std::size_t size) {
+		auto* header = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+		if (header == nullptr) {
+			return nullptr;
+		}
+
+		new (header) Header{ nullptr, UNPOOLED };
+		return header + 1;
+	}
+
+};
+
+} // namespace caramel::poly
+
+#endif /* CARAMELPOLY_POOLALLOCATOR_HPP__ */
@@ -0,0 +1,71 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_REFCOUNT_HPP__
+#define CARAMELPOLY_REFCOUNT_HPP__
+
+#include <atomic>
+#include <cstddef>
+
+namespace caramel::poly {
+
+// Reference count policies for the intrusive shared storage classes.
+//
+// A reference count starts at one. `acquire` adds a reference, `release` drops
+// one and returns true when it was the last one, in which case the caller
+// destroys the shared object. `count` is the current number of references.
+
+// Reference count safe to share between threads.
+class AtomicRefCount {
+public:
+
+	void acquire() noexcept {
+		count_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool release() noexcept {
+		if (count_.fetch_sub(1, std::memory_order_release) == 1) {
+			// Make sure all writes made through other references are visible
+			// to whoever destroys the object.
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return true;
+		}
+		return false;
+	}
+
+	std::size_t count() const noexcept {
+		return count_.load(std::memory_order_acquire);
+	}
+
+private:
+
+	std::atomic<std::size_t> count_{ 1 };
+
+};
+
+// Reference count for objects that never leave a single thread. Acquiring and
+// releasing are plain increments and decrements.
+class NonAtomicRefCount {
+public:
+
+	void acquire() noexcept {
+		++count_;
+	}
+
+	bool release() noexcept {
+		return --count_ == 0;
+	}
+
+	std::size_t count() const noexcept {
+		return count_;
+	}
+
+private:
+
+	std::size_t count_ = 1;
+
+};
+
+} // namespace caramel::poly
+
+#endif /* CARAMELPOLY_REFCOUNT_HPP__ */
@@ -0,0 +1,214 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_RELOCATINGVECTOR_HPP__
+#define CARAMELPOLY_RELOCATINGVECTOR_HPP__
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "relocation.hpp"
+
+namespace caramel::poly {
+
+// A minimal growable array which moves its elements to a new buffer using
+// `caramel::poly::relocate`.
+//
+// When `isTriviallyRelocatable<T>` holds (e.g. for `Poly`s with remote or
+// shared storage), growing the array copies the whole buffer with a single
+// `std::memcpy` instead of calling a move constructor and a destructor for
+// every element. Other elements are moved to the new buffer if their move
+// constructor is `noexcept` and copied otherwise, as with `std::vector`, so
+// that a throwing constructor leaves the array as it was. Elements that can
+// only be moved, like `Poly`s with a local storage and a concept that isn't
+// copy constructible, are moved regardless, and are left moved-from if a move
+// throws (see `caramel::poly::relocate`).
+//
+// Only the operations needed to build and walk a collection of `Poly`s are
+// provided.
+template <class T>
+class RelocatingVector {
+public:
+
+	using value_type = T;
+	using size_type = std::size_t;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	RelocatingVector() = default;
+
+	RelocatingVector(const RelocatingVector&) = delete;
+	RelocatingVector& operator=(const RelocatingVector&) = delete;
+
+	RelocatingVector(RelocatingVector&& other) noexcept :
+		data_{std::exchange(other.data_, nullptr)},
+		size_{std::exchange(other.size_, 0)},
+		capacity_{std::exchange(other.capacity_, 0)}
+	{
+	}
+
+	RelocatingVector& operator=(RelocatingVector&& other) noexcept {
+		RelocatingVector(std::move(other)).swap(*this);
+		return *this;
+	}
+
+	~RelocatingVector() {
+		clear();
+		deallocate(data_, capacity_);
+	}
+
+	void swap(RelocatingVector& other) noexcept {
+		using std::swap;
+		swap(data_, other.data_);
+		swap(size_, other.size_);
+		swap(capacity_, other.capacity_);
+	}
+
+	friend void swap(RelocatingVector& a, RelocatingVector& b) noexcept {
+		a.swap(b);
+	}
+
+	void reserve(size_type capacity) {
+		if (capacity <= capacity_) {
+			return;
+		}
+
+		auto* data = allocate(capacity);
+		try {
+			moveTo(data, capacity);
+		} catch (...) {
+			deallocate(data, capacity);
+			throw;
+		}
+	}
+
+	// When the vector is full, the new element is constructed in the new
+	// buffer before the elements are moved there, so that `args` may refer to
+	// elements of the vector, as with `std::vector`.
+	template <class... Args>
+	T& emplaceBack(Args&&... args) {
+		if (size_ != capacity_) {
+			auto* element = new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+			++size_;
+			return *element;
+		}
+
+		const auto capacity = capacity_ == 0 ? size_type(1) : 2 * capacity_;
+		auto* data = allocate(capacity);
+		T* element;
+		try {
+			element = new (static_cast<void*>(data + size_)) T(std::forward<Args>(args)...);
+		} catch (...) {
+			deallocate(data, capacity);
+			throw;
+		}
+		try {
+			moveTo(data, capacity);
+		} catch (...) {
+			element->~T();
+			deallocate(data, capacity);
+			throw;
+		}
+		++size_;
+		return *element;
+	}
+
+	void pushBack(const T& value) {
+		emplaceBack(value);
+	}
+
+	void pushBack(T&& value) {
+		emplaceBack(std::move(value));
+	}
+
+	void popBack() {
+		assert(size_ != 0 && "caramel::poly::RelocatingVector::popBack: The vector is empty");
+		data_[--size_].~T();
+	}
+
+	void clear() noexcept {
+		std::destroy(data_, data_ + size_);
+		size_ = 0;
+	}
+
+	T& operator[](size_type index) {
+		return data_[index];
+	}
+
+	const T& operator[](size_type index) const {
+		return data_[index];
+	}
+
+	T* data() noexcept {
+		return data_;
+	}
+
+	const T* data() const noexcept {
+		return data_;
+	}
+
+	size_type size() const noexcept {
+		return size_;
+	}
+
+	size_type capacity() const noexcept {
+		return capacity_;
+	}
+
+	bool empty() const noexcept {
+		return size_ == 0;
+	}
+
+	iterator begin() noexcept {
+		return data_;
+	}
+
+	iterator end() noexcept {
+		return data_ + size_;
+	}
+
+	const_iterator begin() const noexcept {
+		return data_;
+	}
+
+	const_iterator end() const noexcept {
+		return data_ + size_;
+	}
+
+private:
+
+	T* data_ = nullptr;
+
+	size_type size_ = 0;
+
+	size_type capacity_ = 0;
+
+	// Relocates the elements to `data`, a new buffer of `capacity` elements,
+	// and frees the old one. If relocation throws, the new buffer is left to the
+	// caller to free.
+	void moveTo(T* data, size_type capacity) {
+		caramel::poly::relocate(data_, size_, data);
+		deallocate(data_, capacity_);
+
+		data_ = data;
+		capacity_ = capacity;
+	}
+
+	static T* allocate(size_type capacity) {
+		return std::allocator<T>().allocate(capacity);
+	}
+
+	static void deallocate(T* data, size_type capacity) noexcept {
+		if (data != nullptr) {
+			std::allocator<T>().deallocate(data, capacity);
+		}
+	}
+
+};
+
+} // namespace caramel::poly
+
+#endif /* CARAMELPOLY_RELOCATINGVECTOR_HPP__ */
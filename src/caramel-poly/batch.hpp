@@ -0,0 +1,295 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_BATCH_HPP__
+#define CARAMELPOLY_BATCH_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/isPlaceholder.hpp"
+#include "Poly.hpp"
+
+namespace caramel::poly {
+
+// Tag selecting the ordered fallback of `invokeAll`, which calls the function
+// on the elements in their order in the range, without grouping them.
+struct InOrder {
+};
+
+constexpr InOrder inOrder{};
+
+namespace detail {
+
+// Assigns consecutive indices to the distinct functions read from vtables it
+// is given, using a small open-addressing hash table of their keys (see
+// `functionKey`).
+template <class Function>
+class FunctionGroups {
+public:
+
+	std::size_t indexOf(const Function& function) {
+		const auto key = functionKey(function);
+		const auto& slot = slots_.empty() ? EMPTY_SLOT : slots_[hash(key)];
+		if (slot.index != NO_INDEX && slot.key == key) {
+			return slot.index;
+		}
+		return insert(function, key);
+	}
+
+	const std::vector<Function>& functions() const noexcept {
+		return functions_;
+	}
+
+private:
+
+	static constexpr auto NO_INDEX = std::numeric_limits<std::size_t>::max();
+
+	struct Slot {
+		std::uintptr_t key;
+		std::size_t index;
+	};
+
+	static constexpr Slot EMPTY_SLOT = Slot{ 0, NO_INDEX };
+
+	std::vector<Function> functions_;
+
+	std::vector<Slot> slots_;
+
+	// 64 minus the base 2 logarithm of the number of slots.
+	unsigned int shift_ = 63;
+
+	// Keys, as function addresses, differ in few, low bits, so they are mixed
+	// with the finalizer of MurmurHash3 before taking the high bits.
+	std::size_t hash(std::uintptr_t key) const noexcept {
+		auto mixed = static_cast<std::uint64_t>(key);
+		mixed ^= mixed >> 33;
+		mixed *= 0xFF51AFD7ED558CCDull;
+		mixed ^= mixed >> 33;
+		mixed *= 0xC4CEB9FE1A85EC53ull;
+		return static_cast<std::size_t>(mixed >> shift_);
+	}
+
+	std::size_t find(std::uintptr_t key) const noexcept {
+		auto slot = hash(key);
+		while (slots_[slot].index != NO_INDEX && slots_[slot].key != key) {
+			slot = (slot + 1) & (slots_.size() - 1);
+		}
+		return slot;
+	}
+
+	// The slow path of `indexOf`, taken for new functions and for functions
+	// that didn't land in their preferred slot.
+	std::size_t insert(const Function& function, std::uintptr_t key) {
+		if (!slots_.empty()) {
+			const auto slot = find(key);
+			if (slots_[slot].index != NO_INDEX) {
+				return slots_[slot].index;
+			}
+		}
+
+		if (4 * (functions_.size() + 1) > slots_.size()) {
+			rehash(slots_.empty() ? 16 : 2 * slots_.size());
+		}
+
+		functions_.push_back(function);
+		slots_[find(key)] = Slot{ key, functions_.size() - 1 };
+		return functions_.size() - 1;
+	}
+
+	void rehash(std::size_t size) {
+		slots_.assign(size, EMPTY_SLOT);
+		shift_ = 64;
+		for (auto s = size; s > 1; s >>= 1) {
+			--shift_;
+		}
+
+		for (auto index = std::size_t(0); index != functions_.size(); ++index) {
+			const auto key = functionKey(functions_[index]);
+			slots_[find(key)] = Slot{ key, index };
+		}
+	}
+
+};
+
+// Buffers used by `invokeAll`, kept around between calls so that batches
+// don't have to allocate, and page in, new memory every time.
+struct BatchBuffers {
+
+	struct Call {
+		std::size_t group;
+		const void* object;
+	};
+
+	std::vector<Call> calls;
+
+	std::vector<const void*> objects;
+
+	std::vector<std::size_t> counts;
+
+private:
+
+	friend class BatchBuffersLease;
+
+	static BatchBuffers& threadBuffers() noexcept {
+		static thread_local BatchBuffers buffers;
+		return buffers;
+	}
+
+};
+
+// Takes the buffers of the calling thread, leaving it without any, since a
+// function called by `invokeAll` may itself call `invokeAll`. They are given
+// back, emptied, when the lease is destroyed, also when a call throws.
+class BatchBuffersLease {
+public:
+
+	BatchBuffersLease() noexcept :
+		buffers_{ std::move(BatchBuffers::threadBuffers()) }
+	{
+	}
+
+	BatchBuffersLease(const BatchBuffersLease&) = delete;
+
+	BatchBuffersLease& operator=(const BatchBuffersLease&) = delete;
+
+	~BatchBuffersLease() {
+		buffers_.calls.clear();
+		buffers_.objects.clear();
+		buffers_.counts.clear();
+		BatchBuffers::threadBuffers() = std::move(buffers_);
+	}
+
+	BatchBuffers* operator->() noexcept {
+		return &buffers_;
+	}
+
+private:
+
+	BatchBuffers buffers_;
+
+};
+
+template <class Poly, class Function>
+constexpr void checkBatchInvocable(Function name) {
+	using Signature = typename decltype(PolyAccess::Concept<Poly>{}.getSignature(name))::Type;
+	static_assert(takesOnlySelf<Signature>,
+		"caramel::poly::invokeAll: The function must take the object as its first parameter, and "
+		"no other placeholders.");
+}
+
+// The placeholder for the object in the signature of the function `Name`
+// of `Poly`.
+template <class Poly, class Name>
+using BatchSelf = typename PlaceholderParameter<0, typename PolyAccess::Signature<Poly, Name>::Type>::Type;
+
+} // namespace detail
+
+// Calls the function `name` on every `Poly` in `range`, passing it `args`.
+// The function must take the object as its first parameter, and no other
+// placeholders. Since the same arguments are passed to every element, they
+// are passed as lvalues. Return values are discarded. A `batchMethod` is
+// called on one object at a time, since the objects are not contiguous.
+//
+// The elements are grouped by the function their vtables point to, and each
+// group is then dispatched in a loop calling the same function pointer, so
+// that the indirect call is predicted correctly for all but the first element
+// of each group. Within a group, the elements are visited in their order in
+// the range, but the groups are visited in the order in which their first
+// elements appear, so calls on elements of different types may be reordered.
+// The `inOrder` overload below is the fallback for when that matters.
+//
+// Grouping costs two passes over the range, so this pays off for ranges of
+// many elements of several types, where a plain loop would mispredict most
+// calls. Since the objects are then visited out of order, the gain is lost
+// for ranges whose objects don't fit in the cache. The buffers used for
+// grouping are kept per thread and reused.
+template <class Range, class Function, class... Args>
+void invokeAll(Range&& range, Function name, Args&&... args) {
+	using Poly = std::remove_reference_t<decltype(*std::begin(range))>;
+	using RawPoly = std::remove_const_t<Poly>;
+	using Object = std::conditional_t<std::is_const_v<Poly>, const void*, void*>;
+	using Entry = decltype(detail::PolyAccess::vtable(std::declval<const RawPoly&>())[name]);
+	using Clause = decltype(detail::PolyAccess::Concept<RawPoly>{}.getSignature(name));
+
+	using Self = detail::BatchSelf<RawPoly, Function>;
+
+	detail::checkBatchInvocable<RawPoly>(name);
+
+	auto lease = detail::BatchBuffersLease();
+	auto& calls = lease->calls;
+	auto& objects = lease->objects;
+	auto& counts = lease->counts;
+	auto groups = detail::FunctionGroups<Entry>();
+
+	calls.resize(static_cast<std::size_t>(std::distance(std::begin(range), std::end(range))));
+	auto call = calls.begin();
+	for (auto& poly : range) {
+		call->group = groups.indexOf(detail::PolyAccess::vtable(poly)[name]);
+		call->object = detail::PolyAccess::objectFor<Self>(poly);
+		++call;
+	}
+
+	counts.resize(groups.functions().size());
+	for (const auto& call : calls) {
+		++counts[call.group];
+	}
+
+	// Counting sort of the objects by group. Afterwards, `counts[group]` is
+	// the end of the group in `objects`.
+	auto offset = std::size_t(0);
+	for (auto& count : counts) {
+		offset += std::exchange(count, offset);
+	}
+
+	objects.resize(calls.size());
+	for (const auto& call : calls) {
+		objects[counts[call.group]++] = call.object;
+	}
+
+	auto begin = std::size_t(0);
+	for (auto group = std::size_t(0); group != counts.size(); ++group) {
+		const auto function = groups.functions()[group];
+		for (auto index = begin; index != counts[group]; ++index) {
+			if constexpr (detail::isBatchMethod<Clause>) {
+				function(static_cast<Object>(const_cast<void*>(objects[index])), std::size_t(1), args...);
+			} else {
+				function(static_cast<Object>(const_cast<void*>(objects[index])), args...);
+			}
+		}
+		begin = counts[group];
+	}
+}
+
+// The ordered fallback of the `invokeAll` above: calls the function `name` on
+// every `Poly` in `range`, in their order in the range, with the same
+// requirements. The calls aren't grouped, so this is just a plain loop, with
+// no buffers and no gain for ranges of mixed types. Use it where the order of
+// the calls is observable, or for short or single-typed ranges, where grouping
+// wouldn't pay off.
+template <class Range, class Function, class... Args>
+void invokeAll(InOrder, Range&& range, Function name, Args&&... args) {
+	using RawPoly = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(range))>>;
+
+	detail::checkBatchInvocable<RawPoly>(name);
+
+	using Clause = decltype(detail::PolyAccess::Concept<RawPoly>{}.getSignature(name));
+	using Self = detail::BatchSelf<RawPoly, Function>;
+
+	for (auto& poly : range) {
+		if constexpr (detail::isBatchMethod<Clause>) {
+			detail::PolyAccess::vtable(poly)[name](detail::PolyAccess::objectFor<Self>(poly), std::size_t(1), args...);
+		} else {
+			detail::PolyAccess::vtable(poly)[name](detail::PolyAccess::objectFor<Self>(poly), args...);
+		}
+	}
+}
+
+} // namespace caramel::poly
+
+#endif /* CARAMELPOLY_BATCH_HPP__ */
@@ -10,10 +10,15 @@
 #define CARAMELPOLY_BUILTIN_HPP__
 
 #include <cstddef>
+#include <cstring>
+#include <new>
 #include <type_traits>
 #include <typeinfo>
+#include <utility>
 
+#include "detail/ConceptTable.hpp"
 #include "detail/ConstexprString.hpp"
+#include "detail/EmptyObject.hpp"
 #include "ConceptMap.hpp"
 #include "Concept.hpp"
 
@@ -25,51 +30,130 @@ constexpr auto DESTRUCT_LABEL = POLY_FUNCTION_LABEL("destruct");
 constexpr auto DEFAULT_CONSTRUCT_LABEL = POLY_FUNCTION_LABEL("default-construct");
 constexpr auto COPY_CONSTRUCT_LABEL = POLY_FUNCTION_LABEL("copy-construct");
 constexpr auto MOVE_CONSTRUCT_LABEL = POLY_FUNCTION_LABEL("move-construct");
+constexpr auto RELOCATE_LABEL = POLY_FUNCTION_LABEL("relocate");
 constexpr auto EQUAL_LABEL = POLY_FUNCTION_LABEL("equal");
+constexpr auto CONCEPTS_LABEL = POLY_FUNCTION_LABEL("concepts");
 
 // Encapsulates the minimal amount of information required to allocate
-// storage for an object of a given type.
+// storage for an object of a given type, and whether objects of the type may
+// be copied bytewise and left undestroyed, which storage classes use to skip
+// calls through the vtable. The flags are conservatively false unless given.
 //
 // This should never be created explicitly; always use `caramel::poly::storageInfoFor`.
 struct StorageInfo {
-	std::size_t size;
-	std::size_t alignment;
+	std::size_t size = 0;
+	std::size_t alignment = 0;
+	bool triviallyCopyable = false;
+	bool triviallyDestructible = false;
 
-	constexpr StorageInfo(std::size_t s, std::size_t a) :
+	constexpr StorageInfo() = default;
+
+	constexpr StorageInfo(std::size_t s, std::size_t a, bool copyable = false, bool destructible = false) :
 		size(s),
-		alignment(a)
+		alignment(a),
+		triviallyCopyable(copyable),
+		triviallyDestructible(destructible)
 	{
 	}
+
+	friend constexpr bool operator==(const StorageInfo& lhs, const StorageInfo& rhs) {
+		return
+			lhs.size == rhs.size &&
+			lhs.alignment == rhs.alignment &&
+			lhs.triviallyCopyable == rhs.triviallyCopyable &&
+			lhs.triviallyDestructible == rhs.triviallyDestructible
+			;
+	}
+
+	friend constexpr bool operator!=(const StorageInfo& lhs, const StorageInfo& rhs) {
+		return !(lhs == rhs);
+	}
 };
 
 template <typename T>
-constexpr auto storageInfoFor = StorageInfo{ sizeof(T), alignof(T) };
-
+constexpr auto storageInfoFor = StorageInfo{
+	sizeof(T),
+	alignof(T),
+	std::is_trivially_copyable<T>::value,
+	std::is_trivially_destructible<T>::value
+	};
+
+// The storage information is held in the vtable itself (see
+// `caramel::poly::constant`), so reading it is a plain load.
 struct Storable : decltype(caramel::poly::requires(
-	STORAGE_INFO_LABEL = caramel::poly::function<caramel::poly::StorageInfo()>
+	STORAGE_INFO_LABEL = caramel::poly::constant<caramel::poly::StorageInfo>
 	))
 {
 };
 
+namespace detail {
+
+// The constants of the builtin concepts, given by function objects that can be
+// called at compile time (see `caramel::poly::constant`).
+template <typename T>
+struct StorageInfoOf {
+	constexpr caramel::poly::StorageInfo operator()() const {
+		// Can't use storageInfoFor here, for Visual C++ it returns { 0, 0 }
+		return caramel::poly::StorageInfo{
+			sizeof(T),
+			alignof(T),
+			std::is_trivially_copyable<T>::value,
+			std::is_trivially_destructible<T>::value
+			};
+	}
+};
+
+template <typename T>
+struct TypeIdOf {
+	constexpr const std::type_info& operator()() const {
+		return typeid(T);
+	}
+};
+
+template <typename T>
+struct ConceptTableOf {
+	constexpr const caramel::poly::detail::ConceptTable& operator()() const {
+		return caramel::poly::detail::CONCEPT_TABLE<T>;
+	}
+};
+
+} // namespace detail
+
 template <typename T>
 auto const defaultConceptMap<Storable, T> = caramel::poly::makeConceptMap(
-	// Can't use storageInfoFor here, for Visual C++ it returns { 0, 0 }
-	STORAGE_INFO_LABEL = []() { return caramel::poly::StorageInfo{ sizeof(T), alignof(T) }; }
+	STORAGE_INFO_LABEL = detail::StorageInfoOf<T>{}
 	);
 
 
+// The `std::type_info` of the type, held in the vtable as a pointer (see
+// `caramel::poly::constant`).
 struct TypeId : decltype(caramel::poly::requires(
-	TYPEID_LABEL = caramel::poly::function<const std::type_info&()>
+	TYPEID_LABEL = caramel::poly::constant<const std::type_info&>
 	))
 {
 };
 
 template <typename T>
 auto const defaultConceptMap<TypeId, T> = caramel::poly::makeConceptMap(
-	TYPEID_LABEL = []() -> const std::type_info& { return typeid(T); }
+	TYPEID_LABEL = detail::TypeIdOf<T>{}
 	);
 
 
+// Lets polys be asked at run time whether the object they hold models other
+// concepts (see `Poly::tryAs`). Objects stored in polys of a `Castable`
+// concept record the vtables of that concept for their type, so the concepts
+// to be queried as well as the concepts queried from should refine this one.
+struct Castable : decltype(caramel::poly::requires(
+	CONCEPTS_LABEL = caramel::poly::constant<const caramel::poly::detail::ConceptTable&>
+	))
+{
+};
+
+template <typename T>
+auto const defaultConceptMap<Castable, T> = caramel::poly::makeConceptMap(
+	CONCEPTS_LABEL = detail::ConceptTableOf<T>{}
+	);
+
 struct DefaultConstructible : decltype(caramel::poly::requires(
 	DEFAULT_CONSTRUCT_LABEL = caramel::poly::function<void (void*)>
 	))
@@ -82,8 +166,11 @@ auto const defaultConceptMap<DefaultConstructible, T, std::enable_if_t<std::is_d
 		DEFAULT_CONSTRUCT_LABEL = [](void* p) { new (p) T(); }
 		);
 
+// Destroys the object. Polys are destroyed in `noexcept` destructors, so the
+// function is `noexcept`, which spares the code destroying objects through
+// vtables any exception edges.
 struct Destructible : decltype(caramel::poly::requires(
-	DESTRUCT_LABEL = caramel::poly::function<void (caramel::poly::SelfPlaceholder&)>
+	DESTRUCT_LABEL = caramel::poly::function<void (caramel::poly::SelfPlaceholder&) noexcept>
 	))
 {
 };
@@ -91,10 +178,64 @@ struct Destructible : decltype(caramel::poly::requires(
 template <typename T>
 auto const defaultConceptMap<Destructible, T, std::enable_if_t<std::is_destructible<T>::value>
 	> = caramel::poly::makeConceptMap(
-		DESTRUCT_LABEL = [](T& self) { self.~T(); }
+		DESTRUCT_LABEL = [](T& self) noexcept { self.~T(); }
+		);
+
+// Move-constructs the object at the given address and destroys the source, in
+// a single call. Storage classes use this to move objects around with half the
+// indirect calls. Trivially copyable objects are simply copied bytewise.
+//
+// The default relocation goes through the move constructor and destructor of
+// the complete concept map, so custom mappings of `MOVE_CONSTRUCT_LABEL` or
+// `DESTRUCT_LABEL` are honored by relocations as well.
+struct Relocatable : decltype(caramel::poly::requires(
+	RELOCATE_LABEL = caramel::poly::function<void (void*, caramel::poly::SelfPlaceholder&&)>
+	))
+{
+};
+
+namespace detail {
+
+template <class T>
+struct DefaultRelocate {
+	void operator()(void* p, T&& other) const noexcept(std::is_nothrow_move_constructible<T>::value) {
+		if constexpr (std::is_trivially_copyable<T>::value) {
+			std::memcpy(p, &other, sizeof(T));
+		} else {
+			new (p) T(std::move(other));
+			other.~T();
+		}
+	}
+};
+
+// Relocates with the functions mapped to `MOVE_CONSTRUCT_LABEL` and
+// `DESTRUCT_LABEL`.
+template <class T, class MoveConstruct, class Destruct>
+struct RelocateWith {
+	void operator()(void* p, T&& other) const
+		noexcept(std::is_nothrow_invocable_v<const MoveConstruct&, void*, T&&>)
+	{
+		caramel::poly::detail::EmptyObject<MoveConstruct>{}.get()(p, std::move(other));
+		caramel::poly::detail::EmptyObject<Destruct>{}.get()(other);
+	}
+};
+
+} // namespace detail
+
+template <typename T>
+auto const defaultConceptMap<Relocatable, T, std::enable_if_t<
+	std::is_move_constructible<T>::value && std::is_destructible<T>::value>
+	> = caramel::poly::makeConceptMap(
+		RELOCATE_LABEL = detail::DefaultRelocate<T>{}
 		);
 
+// The erased move constructor (and relocation) of types whose move
+// constructor can't throw is `noexcept`.
+//
+// Note that refining `Relocatable` costs vtables of move constructible
+// concepts one more function pointer.
 struct MoveConstructible : decltype(caramel::poly::requires(
+	caramel::poly::Relocatable{},
 	MOVE_CONSTRUCT_LABEL = caramel::poly::function<void (void*, caramel::poly::SelfPlaceholder&&)>
 	))
 {
@@ -103,9 +244,42 @@ struct MoveConstructible : decltype(caramel::poly::requires(
 template <typename T>
 auto const defaultConceptMap<MoveConstructible, T, std::enable_if_t<std::is_move_constructible<T>::value>
 	> = caramel::poly::makeConceptMap(
-		MOVE_CONSTRUCT_LABEL = [](void* p, T&& other) { new (p) T(std::move(other)); }
+		MOVE_CONSTRUCT_LABEL = [](void* p, T&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+			new (p) T(std::move(other));
+		}
 		);
 
+namespace detail {
+
+// The default relocation is kept unless the complete concept map has its own
+// move constructor or destructor.
+template <class T, class Map>
+struct ResolvedFunction<DefaultRelocate<T>, Map> {
+	template <class Label, class Entries>
+	using Mapped = typename MappedFunction<std::decay_t<Label>, Entries>::Type;
+
+	using MoveConstruct = Mapped<decltype(MOVE_CONSTRUCT_LABEL), typename Map::Entries>;
+	using Destruct = Mapped<decltype(DESTRUCT_LABEL), typename Map::Entries>;
+
+	using DefaultMoveConstruct = Mapped<
+		decltype(MOVE_CONSTRUCT_LABEL),
+		std::decay_t<decltype(caramel::poly::defaultConceptMap<caramel::poly::MoveConstructible, T>)>
+		>;
+	using DefaultDestruct = Mapped<
+		decltype(DESTRUCT_LABEL),
+		std::decay_t<decltype(caramel::poly::defaultConceptMap<caramel::poly::Destructible, T>)>
+		>;
+
+	using Type = std::conditional_t<
+		std::is_void_v<MoveConstruct> || std::is_void_v<Destruct> ||
+			(std::is_same_v<MoveConstruct, DefaultMoveConstruct> && std::is_same_v<Destruct, DefaultDestruct>),
+		DefaultRelocate<T>,
+		RelocateWith<T, MoveConstruct, Destruct>
+		>;
+};
+
+} // namespace detail
+
 
 struct CopyConstructible : decltype(caramel::poly::requires(
 	caramel::poly::Storable{},
@@ -0,0 +1,81 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_DETAIL_CONCEPTTABLE_HPP__
+#define CARAMELPOLY_DETAIL_CONCEPTTABLE_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace caramel::poly::detail {
+
+// The vtables of the concepts a type models, recorded as objects of that type
+// are stored in polys (see `Castable`), and indexed by a dense index given to
+// each concept.
+//
+// Finding a vtable doesn't lock. Recording one does, and may copy the table
+// to a bigger array, in which case the old one is left alive for the threads
+// that may still be reading it.
+class ConceptTable {
+public:
+
+	constexpr ConceptTable() = default;
+
+	ConceptTable(const ConceptTable&) = delete;
+
+	ConceptTable& operator=(const ConceptTable&) = delete;
+
+	// The index of `Concept`, the same in the tables of all the types.
+	template <class Concept>
+	static std::size_t indexOf() {
+		static const auto index = conceptCount_.fetch_add(1, std::memory_order_relaxed);
+		return index;
+	}
+
+	// The vtable recorded for the concept with the given index, or a null
+	// pointer if there is none.
+	const void* find(std::size_t conceptIndex) const noexcept {
+		const auto* vtables = vtables_.load(std::memory_order_acquire);
+		if (vtables == nullptr || conceptIndex >= vtables->size()) {
+			return nullptr;
+		}
+		return (*vtables)[conceptIndex].load(std::memory_order_acquire);
+	}
+
+	void record(std::size_t conceptIndex, const void* vtable) {
+		const auto lock = std::lock_guard<std::mutex>(mutex_);
+		auto* vtables = vtables_.load(std::memory_order_relaxed);
+		if (vtables == nullptr || conceptIndex >= vtables->size()) {
+			const auto size = vtables == nullptr ? std::size_t(0) : vtables->size();
+			auto* grown = new Entries(std::max(2 * size, conceptIndex + 1));
+			for (auto index = std::size_t(0); index != size; ++index) {
+				(*grown)[index].store((*vtables)[index].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+			vtables_.store(grown, std::memory_order_release);
+			vtables = grown;
+		}
+		(*vtables)[conceptIndex].store(vtable, std::memory_order_release);
+	}
+
+private:
+
+	using Entries = std::vector<std::atomic<const void*>>;
+
+	static inline std::atomic<std::size_t> conceptCount_{ 0 };
+
+	static inline std::mutex mutex_;
+
+	std::atomic<Entries*> vtables_{ nullptr };
+
+};
+
+// The table of the concepts modelled by `T`.
+template <class T>
+inline ConceptTable CONCEPT_TABLE;
+
+} // namespace caramel::poly::detail
+
+#endif /* CARAMELPOLY_DETAIL_CONCEPTTABLE_HPP__ */
@@ -52,7 +52,7 @@ public:
 
 private:
 
-	SecondT second_;
+	SecondT second_{};
 
 };
 
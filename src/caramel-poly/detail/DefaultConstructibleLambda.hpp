@@ -9,6 +9,9 @@
 #ifndef CARAMELPOLY_DETAIL_DEFAULTCONSTRUCTIBLELAMBDA_HPP__
 #define CARAMELPOLY_DETAIL_DEFAULTCONSTRUCTIBLELAMBDA_HPP__
 
+#include <type_traits>
+#include <utility>
+
 #include "caramel-poly/detail/EmptyObject.hpp"
 
 namespace caramel::poly::detail {
@@ -21,7 +24,7 @@ struct DefaultConstructibleLambda<LambdaType, ReturnType (Args...)> {
 
 	using Signature = ReturnType (Args...);
 
-	ReturnType operator()(Args... args) const {
+	ReturnType operator()(Args... args) const noexcept(std::is_nothrow_invocable_v<const LambdaType&, Args...>) {
 		const auto lambda = caramel::poly::detail::EmptyObject<LambdaType>{}.get();
 		return lambda(std::forward<Args>(args)...);
 	}
@@ -33,13 +36,22 @@ struct DefaultConstructibleLambda<LambdaType, void (Args...)> {
 
 	using Signature = void (Args...);
 
-	void operator()(Args... args) const {
+	void operator()(Args... args) const noexcept(std::is_nothrow_invocable_v<const LambdaType&, Args...>) {
 		const auto lambda = caramel::poly::detail::EmptyObject<LambdaType>{}.get();
 		lambda(std::forward<Args>(args)...);
 	}
 
 };
 
+// The lambda given for a `noexcept` signature needn't be `noexcept` itself. The
+// function erasing it is (see `EraseFunction`), so an exception escaping the
+// lambda calls `std::terminate`.
+template <class LambdaType, class ReturnType, class... Args>
+struct DefaultConstructibleLambda<LambdaType, ReturnType (Args...) noexcept> :
+	DefaultConstructibleLambda<LambdaType, ReturnType (Args...)>
+{
+};
+
 } // namespace caramel::poly::detail
 
 #endif /* CARAMELPOLY_DETAIL_DEFAULTCONSTRUCTIBLELAMBDA_HPP__ */
@@ -9,21 +9,25 @@
 #ifndef CARAMELPOLY_DETAIL_ERASEFUNCTION_HPP__
 #define CARAMELPOLY_DETAIL_ERASEFUNCTION_HPP__
 
+#include <type_traits>
 #include <utility>
 
 #include "boost_callable_traits/function_type.hpp"
 #include "EmptyObject.hpp"
 #include "EraserTraits.hpp"
+#include "TransformSignature.hpp"
 
 namespace caramel::poly::detail {
 
-template <class Eraser, class F, class PlaceholderSig, class ActualSig>
+// The function stored in vtables for `F`. It is `noexcept` if the signature
+// is, or if calling `F` can't throw, so that callers need no exception edges.
+template <class Eraser, class F, class PlaceholderSig, class ActualSig, bool NOEXCEPT>
 struct Thunk;
 
-template <class Eraser, class F, class R_pl, class... Args_pl, class R_ac, class... Args_ac>
-struct Thunk<Eraser, F, R_pl (Args_pl...), R_ac (Args_ac...)> {
+template <class Eraser, class F, class R_pl, class... Args_pl, class R_ac, class... Args_ac, bool NOEXCEPT>
+struct Thunk<Eraser, F, R_pl (Args_pl...), R_ac (Args_ac...), NOEXCEPT> {
 	
-	static constexpr auto apply(typename ErasePlaceholder<Eraser, Args_pl>::Type... args)
+	static constexpr auto apply(typename ErasePlaceholder<Eraser, Args_pl>::Type... args) noexcept(NOEXCEPT)
 		-> typename ErasePlaceholder<Eraser, R_pl>::Type
 	{
 		return Erase<Eraser, R_pl>::apply(
@@ -37,10 +41,10 @@ struct Thunk<Eraser, F, R_pl (Args_pl...), R_ac (Args_ac...)> {
 
 };
 
-template <class Eraser, class F, /* void, */ class... Args_pl, class R_ac, class... Args_ac>
-struct Thunk<Eraser, F, void (Args_pl...), R_ac (Args_ac...)> {
+template <class Eraser, class F, /* void, */ class... Args_pl, class R_ac, class... Args_ac, bool NOEXCEPT>
+struct Thunk<Eraser, F, void (Args_pl...), R_ac (Args_ac...), NOEXCEPT> {
 
-	static constexpr auto apply(typename ErasePlaceholder<Eraser, Args_pl>::Type... args)
+	static constexpr auto apply(typename ErasePlaceholder<Eraser, Args_pl>::Type... args) noexcept(NOEXCEPT)
 		-> void
 	{
 		EmptyObject<F>::get()(
@@ -63,10 +67,18 @@ struct Thunk<Eraser, F, void (Args_pl...), R_ac (Args_ac...)> {
 //  - Would it be possible to erase a callable that's not a stateless function
 //    object? Would that necessarily require additional storage?
 //  - Should we be returning a lambda that erases its arguments?
+template <class F, class Signature>
+struct IsNothrowCallable;
+
+template <class F, class R, class... Args>
+struct IsNothrowCallable<F, R (Args...)> : std::is_nothrow_invocable<F, Args...> {
+};
+
 template <class Signature, class Eraser = void, class F>
 constexpr auto EraseFunction(const F&) {
 	using ActualSignature = boost::callable_traits::function_type_t<F>;
-	using Thunk = Thunk<Eraser, F, Signature, ActualSignature>;
+	constexpr auto NOEXCEPT = isNoexceptSignature<Signature> || IsNothrowCallable<const F&, ActualSignature>::value;
+	using Thunk = Thunk<Eraser, F, typename RemoveNoexcept<Signature>::Type, ActualSignature, NOEXCEPT>;
 	return &Thunk::apply;
 }
 
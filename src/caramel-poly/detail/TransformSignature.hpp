@@ -23,6 +23,33 @@ struct TransformSignature<R (Args...), F> {
 	using Type = Result (typename F<Args>::Type...);
 };
 
+template <typename R, typename ...Args, template <typename ...> class F>
+struct TransformSignature<R (Args...) noexcept, F> {
+	using Result = typename F<R>::Type;
+	using Type = Result (typename F<Args>::Type...) noexcept;
+};
+
+// Whether a function type is `noexcept`.
+template <typename Signature>
+constexpr auto isNoexceptSignature = false;
+
+template <typename R, typename ...Args>
+constexpr auto isNoexceptSignature<R (Args...) noexcept> = true;
+
+template <typename R, typename ...Args>
+constexpr auto isNoexceptSignature<R (*)(Args...) noexcept> = true;
+
+// The function type `Signature` without its `noexcept` specifier.
+template <typename Signature>
+struct RemoveNoexcept {
+	using Type = Signature;
+};
+
+template <typename R, typename ...Args>
+struct RemoveNoexcept<R (Args...) noexcept> {
+	using Type = R (Args...);
+};
+
 } // namespace caramel::poly::detail
 
 #endif // CARAMELPOLY_DETAIL_TRANSFORMSIGNATURE_HPP__
@@ -9,6 +9,8 @@
 #ifndef CARAMELPOLY_DETAIL_ISPLACEHOLDER_HPP__
 #define CARAMELPOLY_DETAIL_ISPLACEHOLDER_HPP__
 
+#include <cstddef>
+#include <tuple>
 #include <type_traits>
 
 #include "../SelfPlaceholder.hpp"
@@ -37,6 +39,33 @@ constexpr auto isPlaceholder<const caramel::poly::SelfPlaceholder&&> = true;
 template <>
 constexpr auto isPlaceholder<const caramel::poly::SelfPlaceholder*> = true;
 
+// True if a type is a placeholder for an object that is const.
+template <class Placeholder>
+constexpr bool isConstPlaceholder =
+	std::is_const_v<std::remove_pointer_t<std::remove_reference_t<Placeholder>>>;
+
+// The placeholder parameter at `INDEX` of a signature.
+template <std::size_t INDEX, class Signature>
+struct PlaceholderParameter;
+
+template <std::size_t INDEX, class R, class... Args>
+struct PlaceholderParameter<INDEX, R (Args...)> {
+	using Type = std::tuple_element_t<INDEX, std::tuple<Args...>>;
+	static_assert(isPlaceholder<Type>, "caramel::poly: Expected a placeholder parameter.");
+};
+
+template <std::size_t INDEX, class R, class... Args>
+struct PlaceholderParameter<INDEX, R (Args...) noexcept> : PlaceholderParameter<INDEX, R (Args...)> {
+};
+
+// True if a signature takes the object as its first parameter, and has no other
+// placeholder parameters.
+template <class Signature>
+constexpr auto takesOnlySelf = false;
+
+template <class R, class Self, class... Args>
+constexpr auto takesOnlySelf<R (Self, Args...)> = isPlaceholder<Self> && !(isPlaceholder<Args> || ...);
+
 } // namespace caramel::poly::detail
 
 #endif /* CARAMELPOLY_DETAIL_ISPLACEHOLDER_HPP__ */
@@ -9,6 +9,9 @@
 #ifndef CARAMELPOLY_DSL_HPP__
 #define CARAMELPOLY_DSL_HPP__
 
+#include <cstddef>
+#include <type_traits>
+
 #include "detail/ConstexprList.hpp"
 #include "detail/ConstexprPair.hpp"
 #include "detail/ConstexprString.hpp"
@@ -21,6 +24,14 @@ struct Function {
 	using Type = Signature;
 };
 
+// A `noexcept` function, whose erased function is `noexcept` too, so that
+// calls to it need no exception edges. The function given in the concept map
+// needn't be `noexcept` itself; if it throws, `std::terminate` is called.
+template <class R, class... Args>
+struct Function<R (Args...) noexcept> : Function<R (Args...)> {
+	using Type = R (Args...) noexcept;
+};
+
 template <class Sig1, class Sig2>
 constexpr auto operator==(Function<Sig1>, Function<Sig2>) {
 	return std::is_same_v<Sig1, Sig2>;
@@ -70,6 +81,33 @@ struct Method<R(Args...) const&> {
 	using Type = R (const caramel::poly::SelfPlaceholder&, Args...);
 };
 
+// A `noexcept` method, as in `method<void (int) noexcept>`, is handled like a
+// `noexcept` function (see `caramel::poly::function`).
+template <class R, class... Args>
+struct Method<R(Args...) noexcept> : Method<R(Args...)> {
+	using Type = R (caramel::poly::SelfPlaceholder&, Args...) noexcept;
+};
+
+template <class R, class... Args>
+struct Method<R(Args...) & noexcept> : Method<R(Args...) &> {
+	using Type = R (caramel::poly::SelfPlaceholder&, Args...) noexcept;
+};
+
+template <class R, class... Args>
+struct Method<R(Args...) && noexcept> : Method<R(Args...) &&> {
+	using Type = R (caramel::poly::SelfPlaceholder&&, Args...) noexcept;
+};
+
+template <class R, class... Args>
+struct Method<R(Args...) const noexcept> : Method<R(Args...) const> {
+	using Type = R (const caramel::poly::SelfPlaceholder&, Args...) noexcept;
+};
+
+template <class R, class... Args>
+struct Method<R(Args...) const& noexcept> : Method<R(Args...) const&> {
+	using Type = R (const caramel::poly::SelfPlaceholder&, Args...) noexcept;
+};
+
 // const&& not supported because it's stupid
 
 template <class Sig1, class Sig2>
@@ -82,8 +120,177 @@ constexpr auto operator!=(Method<Sig1> m1, Method<Sig2> m2) {
 	return !(m1 == m2);
 }
 
+template <class Signature>
+struct BatchMethod;
+
+// Right-hand-side of a clause in a concept that signifies a method called on
+// a whole array of objects at once. The resulting function takes a pointer to
+// the first object and the number of objects, followed by the arguments, i.e.
+// `void (caramel::poly::SelfPlaceholder*, std::size_t, Args...)` for a
+// non-const method and the same with a `const caramel::poly::SelfPlaceholder*`
+// for a const one.
+//
+// A concept map may implement such a clause either with a function taking
+// the array (which may then be vectorized), or with a function taking a single
+// object, which is then called in a loop over the array.
+template <class Signature>
+constexpr auto batchMethod = BatchMethod<Signature>{};
+
+template <class... Args>
+struct BatchMethod<void (Args...)> {
+	using Type = void (caramel::poly::SelfPlaceholder*, std::size_t, Args...);
+};
+
+template <class... Args>
+struct BatchMethod<void (Args...) const> {
+	using Type = void (const caramel::poly::SelfPlaceholder*, std::size_t, Args...);
+};
+
+template <class Sig1, class Sig2>
+constexpr auto operator==(BatchMethod<Sig1>, BatchMethod<Sig2>) {
+	return std::is_same_v<Sig1, Sig2>;
+}
+
+template <class Sig1, class Sig2>
+constexpr auto operator!=(BatchMethod<Sig1> m1, BatchMethod<Sig2> m2) {
+	return !(m1 == m2);
+}
+
+// Right-hand-side of a clause in a concept that signifies a constant of type
+// `T`, such as the size of the type or an identifier of it. The concept map
+// provides it with a function taking no arguments, which is called when the
+// vtable is built, so that vtables hold the value itself and reading it is a
+// plain load.
+//
+// Lambdas aren't default constructible before C++20, so concept maps hold
+// them in wrappers that conjure the lambda from nothing to call it, which
+// can't be done in a constant expression. Shared vtables holding constants
+// given by lambdas, or by function objects whose call operator isn't
+// `constexpr`, can thus not be constant initialized. They are built the first
+// time a poly needs them instead, which is safe during static initialization
+// but costs a check whenever a poly is created. Constants should be given by
+// default constructible function objects with a `constexpr` call operator,
+// as those of the builtin concepts are.
+//
+// A reference constant, e.g. `constant<const std::type_info&>`, is held as a
+// pointer to the object referred to.
+template <class T>
+struct Constant {
+	using Type = T ();
+};
+
+template <class T>
+constexpr auto constant = Constant<T>{};
+
+template <class T1, class T2>
+constexpr auto operator==(Constant<T1>, Constant<T2>) {
+	return std::is_same_v<T1, T2>;
+}
+
+template <class T1, class T2>
+constexpr auto operator!=(Constant<T1> c1, Constant<T2> c2) {
+	return !(c1 == c2);
+}
+
+// Right-hand-side of a clause in a concept that signifies a data member of
+// type `T` of the object, such as its position or its key. The concept map
+// binds it to the member with `caramel::poly::member`, as in
+// `POSITION_LABEL = caramel::poly::member<&Particle::position>`, and vtables
+// hold the offset of the member within the object, so that reading it with
+// `Poly::field` is pointer arithmetic rather than a call.
+//
+// Offsets of members given by pointers can't be computed in a constant
+// expression, so shared vtables of concepts with fields are built the first
+// time a poly needs them (see `caramel::poly::constant`).
+template <class T>
+struct Field {
+	using Type = T& (caramel::poly::SelfPlaceholder&);
+	using ValueType = T;
+};
+
+template <class T>
+constexpr auto field = Field<T>{};
+
+template <class T1, class T2>
+constexpr auto operator==(Field<T1>, Field<T2>) {
+	return std::is_same_v<T1, T2>;
+}
+
+template <class T1, class T2>
+constexpr auto operator!=(Field<T1> f1, Field<T2> f2) {
+	return !(f1 == f2);
+}
+
+template <auto MEMBER>
+struct Member {
+	static_assert(std::is_member_object_pointer_v<decltype(MEMBER)>,
+		"caramel::poly::member: Fields may only be bound to pointers to data members.");
+};
+
+// Binds a field clause to the data member `MEMBER` in a concept map (see
+// `caramel::poly::field`).
+template <auto MEMBER>
+constexpr auto member = Member<MEMBER>{};
+
+// A clause marked as hot, i.e. whose function is called often enough that it
+// should be kept in the vtable object itself rather than behind a pointer.
+// Clauses are cold unless marked. The mark is only looked at by vtable
+// selectors (see `OnlyHot` and `AutoVTable`); otherwise, a hot clause is the
+// same as the clause itself.
+template <class Clause>
+struct Hot : Clause {
+};
+
+// Marks a clause as hot, as in `DRAW_LABEL = hot(method<void () const>)`.
+template <class Clause>
+constexpr Hot<Clause> hot(Clause) {
+	return {};
+}
+
 namespace detail {
 
+template <class Clause>
+constexpr auto isMethod = false;
+
+template <class Signature>
+constexpr auto isMethod<caramel::poly::Method<Signature>> = true;
+
+template <class Clause>
+constexpr auto isMethod<caramel::poly::Hot<Clause>> = isMethod<Clause>;
+
+template <class Clause>
+constexpr auto isBatchMethod = false;
+
+template <class Signature>
+constexpr auto isBatchMethod<caramel::poly::BatchMethod<Signature>> = true;
+
+template <class Clause>
+constexpr auto isBatchMethod<caramel::poly::Hot<Clause>> = isBatchMethod<Clause>;
+
+template <class Clause>
+constexpr auto isConstant = false;
+
+template <class T>
+constexpr auto isConstant<caramel::poly::Constant<T>> = true;
+
+template <class Clause>
+constexpr auto isConstant<caramel::poly::Hot<Clause>> = isConstant<Clause>;
+
+template <class Clause>
+constexpr auto isField = false;
+
+template <class T>
+constexpr auto isField<caramel::poly::Field<T>> = true;
+
+template <class Clause>
+constexpr auto isField<caramel::poly::Hot<Clause>> = isField<Clause>;
+
+template <class Clause>
+constexpr auto isHotClause = false;
+
+template <class Clause>
+constexpr auto isHotClause<caramel::poly::Hot<Clause>> = true;
+
 template <class Name, class... Args>
 class DelayedCall {
 public:
@@ -0,0 +1,66 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#ifndef CARAMELPOLY_RELOCATION_HPP__
+#define CARAMELPOLY_RELOCATION_HPP__
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace caramel::poly {
+
+// Whether objects of type `T` may be relocated, i.e. moved to a new address
+// with the source ending its lifetime, by copying their bytes with
+// `std::memcpy`, without calling any constructor or destructor.
+//
+// This holds for trivially copyable types, and for types that only hold
+// pointers to things living elsewhere. Specialize it as `true` for the latter;
+// the storage classes and `Poly` do so where appropriate.
+//
+// Types that can't be moved at all (like the storage classes, which may only
+// be moved with the help of a vtable) are not considered trivially copyable
+// here, even by compilers that report them as such.
+template <class T>
+constexpr bool isTriviallyRelocatable =
+	std::is_trivially_copyable_v<T> &&
+	std::is_trivially_destructible_v<T> &&
+	(std::is_trivially_move_constructible_v<T> || std::is_trivially_copy_constructible_v<T>);
+
+// Whether objects of type `T` may be copied by `relocate`, which
+// `std::is_copy_constructible` says unless specialized. `Poly`, whose copy
+// constructor is declared even if its concept can't be copied, does so.
+template <class T>
+constexpr bool isCopyConstructible = std::is_copy_constructible_v<T>;
+
+// Relocates `count` objects from `from` to the uninitialized memory at `to`.
+// Afterwards, the objects at `from` are destroyed, and the memory can be
+// reused or freed. The two ranges must not overlap. Trivially relocatable
+// objects are copied in one `std::memcpy`; others are moved one by one.
+//
+// Like `std::vector`, objects whose move constructor may throw are copied
+// instead if they can be (see `isCopyConstructible`), so that they are left
+// untouched at `from` if a constructor throws. Objects that may only be moved
+// with a throwing move constructor are left moved-from in that case.
+template <class T>
+void relocate(T* from, std::size_t count, T* to) {
+	if constexpr (isTriviallyRelocatable<T>) {
+		if (count != 0) {
+			std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+		}
+	} else {
+		// If a constructor throws, the objects already built at `to` are
+		// destroyed and the ones at `from` are left alive.
+		if constexpr (std::is_nothrow_move_constructible_v<T> || !isCopyConstructible<T>) {
+			std::uninitialized_move(from, from + count, to);
+		} else {
+			std::uninitialized_copy(from, from + count, to);
+		}
+		std::destroy(from, from + count);
+	}
+}
+
+} // namespace caramel::poly
+
+#endif /* CARAMELPOLY_RELOCATION_HPP__ */
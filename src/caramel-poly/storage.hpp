@@ -9,13 +9,21 @@
 #ifndef CARAMELPOLY_STORAGE_HPP__
 #define CARAMELPOLY_STORAGE_HPP__
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <type_traits>
 #include <utility>
 
+#include "Arena.hpp"
+#include "RefCount.hpp"
+#include "relocation.hpp"
 #include "dsl.hpp"
 #include "builtin.hpp"
 
@@ -59,6 +67,12 @@ struct MallocAllocator {
 //             could be too large to fit in a predefined buffer size, in which
 //             case this call would not compile.
 //
+// template <class Resource, class T> Storage(std::allocator_arg_t, Resource&&, T&&);
+//  Semantics: Optional. Same as above, but obtain any memory needed for the
+//             object from the given resource (e.g. an `Arena`). Storage classes
+//             that can't work without such a resource provide only this
+//             constructor.
+//
 // template <class VTable> Storage(const Storage&, const VTable&);
 //  Semantics: Copy-construct the contents of the polymorphic storage,
 //             assuming the contents of the source storage can be
@@ -102,219 +116,1098 @@ struct MallocAllocator {
 //             storage. If `T` is not the actual type of the object stored
 //             inside the polymorphic storage, the behavior is undefined.
 //
+// template <class T = void, class VTable> T* get(const VTable&);
+//  Semantics: Optional. Same as `get()`, but the caller may modify the object
+//             through the returned pointer, and the object can be manipulated
+//             using the provided vtable. This gives storage classes that share
+//             objects a chance to unshare them first. When available, `Poly`
+//             uses it for every non-const access to the object.
+//
+// template <class T = void, class VTable> const T* get(const VTable&) const;
+//  Semantics: Optional. Same as `get() const`, but the object can be
+//             manipulated using the provided vtable. When available, `Poly`
+//             uses it for every const access to the object. Storage classes
+//             that can't find the object without its vtable (e.g.
+//             `CompactSBOStorage`) provide both overloads taking a vtable, and
+//             needn't support `get()`.
+//
 // static constexpr bool canStore(caramel::poly::StorageInfo);
 //  Semantics: Return whether the polymorphic storage can store an object with
 //             the specified type information.
+//
+// Storage classes whose move constructor and `swap` can't throw should declare
+// them `noexcept`, which makes the move operations of `Poly` `noexcept`. Those
+// only holding pointers should also specialize `isTriviallyRelocatable` (see
+// `relocation.hpp`), which allows containers to move `Poly`s around with
+// `std::memcpy`.
+
+namespace detail {
+
+// Destroys the object at `object` for good, unless the storage information in
+// the vtable says it is trivially destructible, in which case there is nothing
+// to call. Moved-from objects are destroyed with `DESTRUCT_LABEL` directly,
+// where the extra branch costs more than the call it saves.
+template <class VTable>
+void destroy(const VTable& vtable, void* object) {
+	if constexpr (VTable{}.contains(STORAGE_INFO_LABEL)) {
+		if (vtable[STORAGE_INFO_LABEL].triviallyDestructible) {
+			return;
+		}
+	}
+	vtable[DESTRUCT_LABEL](object);
+}
+
+// Moves the object at `from` to `to` and destroys the source, in a single call
+// if the vtable has `RELOCATE_LABEL`.
+template <class VTable>
+void relocate(const VTable& vtable, void* to, void* from) {
+	if constexpr (VTable{}.contains(RELOCATE_LABEL)) {
+		vtable[RELOCATE_LABEL](to, from);
+	} else {
+		vtable[MOVE_CONSTRUCT_LABEL](to, from);
+		vtable[DESTRUCT_LABEL](from);
+	}
+}
+
+// Where an `SBOBase` keeps its object. Trivially copyable inline objects are
+// remembered as such, so that they can be moved around with `std::memcpy`
+// rather than through the vtable.
+enum class SBOState : unsigned char {
+	INLINE,
+	INLINE_TRIVIAL,
+	HEAP,
+};
+
+// Raw buffer of `SIZE` bytes aligned to `ALIGN`, which defaults to the
+// alignment `std::aligned_storage_t` picks for `SIZE`.
+template <std::size_t SIZE, std::size_t ALIGN = static_cast<std::size_t>(-1)>
+class AlignedBuffer {
+public:
+
+	static constexpr std::size_t CAPACITY = SIZE;
+	static constexpr std::size_t ALIGNMENT =
+		(ALIGN == static_cast<std::size_t>(-1)) ? alignof(std::aligned_storage_t<SIZE>) : ALIGN;
+
+	static constexpr bool canStore(caramel::poly::StorageInfo info) {
+		return info.size <= CAPACITY && ALIGNMENT % info.alignment == 0;
+	}
+
+	void* get() {
+		return &bytes_;
+	}
+
+	const void* get() const {
+		return &bytes_;
+	}
+
+private:
+
+	std::aligned_storage_t<SIZE, ALIGNMENT> bytes_;
+
+};
+
+// Raw buffer able to hold an object of up to `SIZE` bytes, aligned to any
+// power of two up to `MAX_ALIGN`, without requiring `MAX_ALIGN` alignment of
+// the buffer itself. Objects are always placed at the first `MAX_ALIGN`-aligned
+// address within the buffer, so they can be found again by rounding up the
+// buffer address, and the buffer is padded so that `SIZE` bytes fit past that
+// address wherever the buffer lies.
+template <std::size_t SIZE, std::size_t MAX_ALIGN>
+class OverAlignedBuffer {
+public:
+
+	static_assert(MAX_ALIGN != 0 && (MAX_ALIGN & (MAX_ALIGN - 1)) == 0,
+		"caramel::poly::OverAlignedBuffer: MAX_ALIGN must be a power of two");
+
+	static constexpr std::size_t CAPACITY = SIZE;
+	static constexpr std::size_t BASE_ALIGN =
+		(MAX_ALIGN < alignof(std::max_align_t)) ? MAX_ALIGN : alignof(std::max_align_t);
+
+	static constexpr bool canStore(caramel::poly::StorageInfo info) {
+		return info.size <= SIZE && MAX_ALIGN % info.alignment == 0;
+	}
+
+	void* get() {
+		return bytes_ + offset();
+	}
+
+	const void* get() const {
+		return bytes_ + offset();
+	}
+
+private:
+
+	alignas(BASE_ALIGN) unsigned char bytes_[SIZE + MAX_ALIGN - BASE_ALIGN];
+
+	std::size_t offset() const {
+		const auto address = reinterpret_cast<std::uintptr_t>(bytes_);
+		return ((address + MAX_ALIGN - 1) & ~(MAX_ALIGN - 1)) - address;
+	}
+
+};
+
+// Slot keeping the object in `Buffer` when it fits, and the pointer to it in
+// the same bytes otherwise, with a separate byte telling them apart.
+template <class Buffer>
+class FlaggedSlot {
+public:
+
+	static constexpr bool CAN_INLINE = true;
+	static constexpr bool CAN_SPILL = true;
+	static constexpr bool KEEPS_STATE = true;
+	static constexpr std::size_t CAPACITY = Buffer::CAPACITY;
+
+	static constexpr bool canStore(caramel::poly::StorageInfo info) {
+		return Buffer::canStore(info);
+	}
+
+	SBOState state() const {
+		return state_;
+	}
+
+	void setState(SBOState state) {
+		state_ = state;
+	}
+
+	void* buffer() {
+		return buffer_.get();
+	}
+
+	const void* buffer() const {
+		return buffer_.get();
+	}
+
+	void* pointer() const {
+		return ptr_;
+	}
+
+	void setHeap(void* ptr) {
+		ptr_ = ptr;
+		state_ = SBOState::HEAP;
+	}
+
+private:
+
+	union {
+		void* ptr_;
+		Buffer buffer_;
+	};
+
+	SBOState state_;
+
+};
+
+// Slot without any bookkeeping besides its `SIZE` bytes, all of which may hold
+// an inline object. The pointer to a heap object is kept in the first ones.
+// Whether the object is inline is told by its storage information, read from
+// the vtable, so the slot records no state.
+template <std::size_t SIZE, std::size_t ALIGN>
+class BareSlot {
+public:
+
+	static constexpr bool CAN_INLINE = true;
+	static constexpr bool CAN_SPILL = true;
+	static constexpr bool KEEPS_STATE = false;
+	static constexpr std::size_t CAPACITY = SIZE;
+
+	static constexpr bool canStore(caramel::poly::StorageInfo info) {
+		return info.size <= CAPACITY && ALIGN % info.alignment == 0;
+	}
+
+	void setState(SBOState) {
+	}
+
+	void* buffer() {
+		return bytes_;
+	}
+
+	const void* buffer() const {
+		return bytes_;
+	}
+
+	void* pointer() const {
+		return *reinterpret_cast<void* const*>(bytes_);
+	}
+
+	void setHeap(void* ptr) {
+		new (bytes_) void*(ptr);
+	}
+
+private:
+
+	alignas(ALIGN) unsigned char bytes_[SIZE];
+
+};
+
+// Slot of the storages that always keep their object inline, in `Buffer`. It
+// records nothing, so inline objects are always relocated through the vtable.
+template <class Buffer>
+class InlineSlot {
+public:
+
+	static constexpr bool CAN_INLINE = true;
+	static constexpr bool CAN_SPILL = false;
+	static constexpr bool KEEPS_STATE = true;
+	static constexpr std::size_t CAPACITY = Buffer::CAPACITY;
+
+	static constexpr bool canStore(caramel::poly::StorageInfo info) {
+		return Buffer::canStore(info);
+	}
+
+	SBOState state() const {
+		return SBOState::INLINE;
+	}
+
+	void setState(SBOState) {
+	}
+
+	void* buffer() {
+		return buffer_.get();
+	}
+
+	const void* buffer() const {
+		return buffer_.get();
+	}
+
+private:
+
+	Buffer buffer_;
+
+};
+
+// Slot of the storages that always keep their object on the heap.
+class HeapSlot {
+public:
+
+	static constexpr bool CAN_INLINE = false;
+	static constexpr bool CAN_SPILL = true;
+	static constexpr bool KEEPS_STATE = true;
+
+	static constexpr bool canStore(caramel::poly::StorageInfo) {
+		return false;
+	}
+
+	void* pointer() const {
+		return ptr_;
+	}
+
+	void setHeap(void* ptr) {
+		ptr_ = ptr;
+	}
+
+private:
+
+	void* ptr_;
+
+};
+
+// Heap policy allocating from a static `Allocator` policy, such as
+// `MallocAllocator`. `deallocate` gives back memory whose object couldn't be
+// constructed, and `release` destroys a heap object and gives its memory back.
+template <class Allocator>
+struct AllocatorHeap {
+	void* allocate(caramel::poly::StorageInfo info) {
+		auto* ptr = Allocator::allocate(info.size);
+		if (ptr == nullptr) {
+			throw std::bad_alloc();
+		}
+		return ptr;
+	}
+
+	void deallocate(void* ptr, caramel::poly::StorageInfo) noexcept {
+		Allocator::free(ptr);
+	}
+
+	template <class VTable>
+	void release(const VTable& vtable, void* ptr) {
+		detail::destroy(vtable, ptr);
+		Allocator::free(ptr);
+	}
+};
+
+// Heap policy allocating from a `std::pmr::memory_resource`, which it keeps so
+// that memory is given back to the resource it came from.
+struct PmrHeap {
+	std::pmr::memory_resource* resource;
+
+	void* allocate(caramel::poly::StorageInfo info) {
+		return resource->allocate(info.size, info.alignment);
+	}
+
+	void deallocate(void* ptr, caramel::poly::StorageInfo info) noexcept {
+		resource->deallocate(ptr, info.size, info.alignment);
+	}
+
+	template <class VTable>
+	void release(const VTable& vtable, void* ptr) {
+		const auto info = vtable[STORAGE_INFO_LABEL];
+		detail::destroy(vtable, ptr);
+		resource->deallocate(ptr, info.size, info.alignment);
+	}
+};
+
+// Heap policy bump-allocating from an `Arena`, which only gives memory back in
+// bulk. Releasing an object thus only destroys it, and not even that if it is
+// trivially destructible, which is remembered in the lowest bit of the address
+// of the arena.
+class ArenaHeap {
+public:
+
+	explicit ArenaHeap(caramel::poly::Arena& arena) :
+		arena_{reinterpret_cast<std::uintptr_t>(&arena)}
+	{
+	}
+
+	void* allocate(caramel::poly::StorageInfo info) {
+		auto* ptr = arena()->allocate(info.size, info.alignment);
+		if (ptr == nullptr) {
+			throw std::bad_alloc();
+		}
+		arena_ = reinterpret_cast<std::uintptr_t>(arena()) |
+			(info.triviallyDestructible ? TRIVIALLY_DESTRUCTIBLE_BIT : 0);
+		return ptr;
+	}
+
+	void deallocate(void*, caramel::poly::StorageInfo) noexcept {
+	}
+
+	template <class VTable>
+	void release(const VTable& vtable, void* ptr) {
+		if ((arena_ & TRIVIALLY_DESTRUCTIBLE_BIT) == 0) {
+			detail::destroy(vtable, ptr);
+		}
+	}
+
+	caramel::poly::Arena* arena() const {
+		return reinterpret_cast<caramel::poly::Arena*>(arena_ & ~TRIVIALLY_DESTRUCTIBLE_BIT);
+	}
+
+private:
+
+	// Arena objects are at least pointer-aligned, which leaves the lowest bit of
+	// their address free.
+	static constexpr std::uintptr_t TRIVIALLY_DESTRUCTIBLE_BIT = 1;
+
+	static_assert(alignof(caramel::poly::Arena) > TRIVIALLY_DESTRUCTIBLE_BIT);
+
+	std::uintptr_t arena_;
+
+};
+
+// Heap policy of the storages that never spill to the heap.
+struct NoHeap {
+};
+
+// The implementation shared by the storage classes that keep their object
+// either inline or on the heap. `Slot` lays out the inline object, or the
+// pointer to the heap one, and records which of the two it holds (see
+// `FlaggedSlot`, `InlineSlot` and `HeapSlot`) unless it leaves that to the
+// storage information of the object (see `BareSlot`); `Heap` allocates the
+// objects that don't fit inline (see `AllocatorHeap`, `PmrHeap` and
+// `ArenaHeap`). Slots that only ever hold one of the two say so with
+// `CAN_INLINE` and `CAN_SPILL`.
+//
+// A moved-from storage holds a null heap pointer, so that destructing it
+// doesn't do anything. Storages whose slot doesn't record its state can't
+// be emptied that way, so their inline objects are moved rather than
+// relocated, and they can only give the object given its vtable.
+template <class Slot, class Heap>
+class SBOBase : private Slot, private Heap {
+public:
+
+	SBOBase() = delete;
+	SBOBase(const SBOBase&) = delete;
+	SBOBase(SBOBase&&) = delete;
+	SBOBase& operator=(SBOBase&&) = delete;
+	SBOBase& operator=(const SBOBase&) = delete;
+
+	template <class T, class RawT = std::decay_t<T>>
+	SBOBase(std::allocator_arg_t, Heap heap, T&& t) :
+		Heap(std::move(heap))
+	{
+		constexpr auto info = caramel::poly::storageInfoFor<RawT>;
+		if constexpr (Slot::canStore(info)) {
+			new (slot().buffer()) RawT(std::forward<T>(t));
+			slot().setState(std::is_trivially_copyable_v<RawT> ? SBOState::INLINE_TRIVIAL : SBOState::INLINE);
+		} else if constexpr (Slot::CAN_SPILL) {
+			slot().setHeap(constructOnHeap(info, [&t](void* ptr) { new (ptr) RawT(std::forward<T>(t)); }));
+		}
+	}
+
+	template <class VTable>
+	SBOBase(const SBOBase& other, const VTable& vtable) :
+		Heap(other.heap())
+	{
+		const auto state = stateOf(vtable, other.slot());
+		if (state == SBOState::HEAP) {
+			if constexpr (Slot::CAN_SPILL) {
+				slot().setHeap(constructOnHeap(vtable[STORAGE_INFO_LABEL], [&](void* ptr) {
+					vtable[COPY_CONSTRUCT_LABEL](ptr, other.slot().pointer());
+				}));
+			}
+		} else if constexpr (Slot::CAN_INLINE) {
+			assert((Slot::CAN_SPILL || Slot::canStore(vtable[STORAGE_INFO_LABEL])) &&
+				"caramel::poly::LocalStorage: Trying to copy-construct using a vtable that "
+				"describes an object that won't fit in the storage.");
+
+			vtable[COPY_CONSTRUCT_LABEL](slot().buffer(), other.slot().buffer());
+			slot().setState(state);
+		}
+	}
+
+	// Inline objects are relocated if the vtable can do it in a single call,
+	// leaving `other` empty.
+	template <class VTable>
+	SBOBase(SBOBase&& other, const VTable& vtable) noexcept(!Slot::CAN_INLINE) :
+		Heap(other.heap())
+	{
+		const auto state = stateOf(vtable, other.slot());
+		if (state == SBOState::HEAP) {
+			if constexpr (Slot::CAN_SPILL) {
+				slot().setHeap(other.slot().pointer());
+				other.slot().setHeap(nullptr);
+			}
+		} else if constexpr (Slot::CAN_INLINE) {
+			assert((Slot::CAN_SPILL || Slot::canStore(vtable[STORAGE_INFO_LABEL])) &&
+				"caramel::poly::LocalStorage: Trying to move-construct using a vtable that "
+				"describes an object that won't fit in the storage.");
+
+			if constexpr (Slot::CAN_SPILL && Slot::KEEPS_STATE && canRelocate<VTable>) {
+				relocate(vtable, slot(), other.slot());
+				other.slot().setHeap(nullptr);
+			} else {
+				vtable[MOVE_CONSTRUCT_LABEL](slot().buffer(), other.slot().buffer());
+				slot().setState(state);
+			}
+		}
+	}
+
+	// Heap objects are swapped along with the heap they were allocated from.
+	template <class ThisVTable, class OtherVTable>
+	void swap(const ThisVTable& thisVTable, SBOBase& other, const OtherVTable& otherVTable) noexcept(!Slot::CAN_INLINE) {
+		if (this == &other) {
+			return;
+		}
+
+		using std::swap;
+		swap(this->heap(), other.heap());
+
+		if constexpr (!Slot::CAN_INLINE) {
+			swapPointers(other);
+		} else if constexpr (!Slot::CAN_SPILL) {
+			swapInline(thisVTable, other, otherVTable);
+		} else if (stateOf(thisVTable, this->slot()) == SBOState::HEAP) {
+			if (stateOf(otherVTable, other.slot()) == SBOState::HEAP) {
+				swapPointers(other);
+			} else {
+				void* ptr = this->slot().pointer();
+
+				// Bring `other`'s contents to `*this`, destructively
+				relocate(otherVTable, this->slot(), other.slot());
+
+				// Bring `*this`'s stuff to `other`
+				other.slot().setHeap(ptr);
+			}
+		} else if (stateOf(otherVTable, other.slot()) == SBOState::HEAP) {
+			void* ptr = other.slot().pointer();
+
+			// Bring `*this`'s contents to `other`, destructively
+			relocate(thisVTable, other.slot(), this->slot());
+
+			// Bring `other`'s stuff to `*this`
+			this->slot().setHeap(ptr);
+		} else {
+			swapInline(thisVTable, other, otherVTable);
+		}
+	}
+
+	template <class VTable>
+	void destruct(const VTable& vtable) {
+		const auto state = stateOf(vtable, slot());
+		if (state == SBOState::HEAP) {
+			if constexpr (Slot::CAN_SPILL) {
+				// If we've been moved from, don't do anything.
+				if (auto* ptr = slot().pointer(); ptr != nullptr) {
+					heap().release(vtable, ptr);
+				}
+			}
+		} else if constexpr (Slot::CAN_INLINE) {
+			// Trivially copyable types are trivially destructible.
+			if (state != SBOState::INLINE_TRIVIAL) {
+				detail::destroy(vtable, slot().buffer());
+			}
+		}
+	}
+
+	template <class T = void>
+	T* get() {
+		static_assert(Slot::KEEPS_STATE,
+			"caramel::poly::CompactSBOStorage: The object can only be found given its vtable.");
+		return static_cast<T*>(object(*this, stateOf(NoVTable{}, slot())));
+	}
+
+	template <class T = void>
+	const T* get() const {
+		static_assert(Slot::KEEPS_STATE,
+			"caramel::poly::CompactSBOStorage: The object can only be found given its vtable.");
+		return static_cast<const T*>(object(*this, stateOf(NoVTable{}, slot())));
+	}
+
+	template <class T = void, class VTable>
+	T* get(const VTable& vtable) noexcept {
+		return static_cast<T*>(object(*this, stateOf(vtable, slot())));
+	}
+
+	template <class T = void, class VTable>
+	const T* get(const VTable& vtable) const noexcept {
+		return static_cast<const T*>(object(*this, stateOf(vtable, slot())));
+	}
+
+	// Whether objects described by `info` are kept inline. Storages that never
+	// keep them inline can store any object.
+	static constexpr bool canStore(caramel::poly::StorageInfo info) {
+		return !Slot::CAN_INLINE || Slot::canStore(info);
+	}
+
+protected:
+
+	Heap& heap() {
+		return *this;
+	}
+
+	const Heap& heap() const {
+		return *this;
+	}
+
+private:
+
+	template <class VTable>
+	static constexpr bool canRelocate = VTable{}.contains(RELOCATE_LABEL);
+
+	// Stands for the vtable where the slot doesn't need one.
+	struct NoVTable {
+	};
+
+	Slot& slot() {
+		return *this;
+	}
+
+	const Slot& slot() const {
+		return *this;
+	}
+
+	// Where `slot` keeps the object that `vtable` describes. Slots that don't
+	// record it keep the object inline exactly when its storage information
+	// says it fits, as when it was constructed.
+	template <class VTable>
+	static SBOState stateOf(const VTable& vtable, const Slot& slot) {
+		if constexpr (!Slot::CAN_SPILL) {
+			return SBOState::INLINE;
+		} else if constexpr (!Slot::CAN_INLINE) {
+			return SBOState::HEAP;
+		} else if constexpr (Slot::KEEPS_STATE) {
+			return slot.state();
+		} else {
+			const auto info = vtable[STORAGE_INFO_LABEL];
+			if (!Slot::canStore(info)) {
+				return SBOState::HEAP;
+			}
+			return info.triviallyCopyable ? SBOState::INLINE_TRIVIAL : SBOState::INLINE;
+		}
+	}
+
+	template <class Self>
+	static auto object(Self& self, SBOState state) {
+		if constexpr (!Slot::CAN_SPILL) {
+			return self.slot().buffer();
+		} else if constexpr (!Slot::CAN_INLINE) {
+			return self.slot().pointer();
+		} else {
+			return state == SBOState::HEAP ? self.slot().pointer() : self.slot().buffer();
+		}
+	}
+
+	// Allocates memory for an object described by `info` and builds the object
+	// there with `construct`, giving the memory back if that throws.
+	template <class Construct>
+	void* constructOnHeap(caramel::poly::StorageInfo info, Construct construct) {
+		auto* ptr = heap().allocate(info);
+		try {
+			construct(ptr);
+		} catch (...) {
+			heap().deallocate(ptr, info);
+			throw;
+		}
+		return ptr;
+	}
+
+	void swapPointers(SBOBase& other) {
+		void* ptr = this->slot().pointer();
+		this->slot().setHeap(other.slot().pointer());
+		other.slot().setHeap(ptr);
+	}
+
+	template <class ThisVTable, class OtherVTable>
+	void swapInline(const ThisVTable& thisVTable, SBOBase& other, const OtherVTable& otherVTable) {
+		// Move `other` into temporary local storage, destructively.
+		Slot tmp;
+		relocate(otherVTable, tmp, other.slot());
+
+		// Move `*this` into `other`, destructively.
+		relocate(thisVTable, other.slot(), this->slot());
+
+		// Now, bring `tmp` into `*this`, destructively.
+		relocate(otherVTable, this->slot(), tmp);
+	}
+
+	// Moves the inline object of `from` to `to` and destroys the source.
+	template <class VTable>
+	static void relocate(const VTable& vtable, Slot& to, Slot& from) {
+		const auto state = stateOf(vtable, from);
+		if (state == SBOState::INLINE_TRIVIAL) {
+			std::memcpy(to.buffer(), from.buffer(), Slot::CAPACITY);
+		} else {
+			detail::relocate(vtable, to.buffer(), from.buffer());
+		}
+		to.setState(state);
+	}
+
+};
+
+} // namespace detail
 
 // Class implementing the small buffer optimization (SBO).
 //
 // This class represents a value of an unknown type that is stored either on
 // the heap, or on the stack if it fits in the specific small buffer size.
-//
-// TODO: - Consider having ptr_ always point to either sb_ or the heap.
-//       - Alternatively, if we had a way to access the vtable here, we could
-//         retrieve the size of the type from it and get rid of `uses_heap_`.
-//       - We could also use the low bits of the pointer to the vtable for
-//         `uses_heap_`.
+// `CompactSBOStorage` does without the byte recording which.
 template <
 	std::size_t SIZE,
 	std::size_t ALIGN = static_cast<std::size_t>(-1),
 	class Allocator = MallocAllocator
 	>
-class SBOStorage {
+class SBOStorage :
+	public detail::SBOBase<
+		detail::FlaggedSlot<detail::AlignedBuffer<std::max(SIZE, sizeof(void*)), ALIGN>>,
+		detail::AllocatorHeap<Allocator>
+		>
+{
+public:
+
+	SBOStorage() = delete;
+	SBOStorage(const SBOStorage&) = delete;
+	SBOStorage(SBOStorage&&) = delete;
+	SBOStorage& operator=(SBOStorage&&) = delete;
+	SBOStorage& operator=(const SBOStorage&) = delete;
+
+	template <class T>
+	explicit SBOStorage(T&& t) :
+		Base{ std::allocator_arg, detail::AllocatorHeap<Allocator>{}, std::forward<T>(t) }
+	{
+	}
+
+	template <class VTable>
+	SBOStorage(const SBOStorage& other, const VTable& vtable) :
+		Base{ other, vtable }
+	{
+	}
+
+	template <class VTable>
+	SBOStorage(SBOStorage&& other, const VTable& vtable) :
+		Base{ std::move(other), vtable }
+	{
+	}
+
+private:
+
+	using Base = typename SBOStorage::SBOBase;
+
+};
+
+// Class implementing the small buffer optimization without any bookkeeping
+// besides the buffer itself, so that `sizeof(CompactSBOStorage<SIZE>) == SIZE`.
+//
+// Whether the object lives in the buffer or on the heap isn't recorded: it is
+// worked out from the storage information in the vtable, a single load in any
+// vtable since constants are kept there. Objects of up to `SIZE` bytes, and
+// suitably aligned, are thus stored inline. When the object is on the heap, the
+// buffer holds the pointer to it.
+//
+// This means that the object can only be found given its vtable, through
+// `get(vtable)`, which `Poly` uses where storages provide it; `get()` doesn't
+// compile. The vtable must describe the object by its own storage information,
+// as the one built from its concept map does.
+//
+// The default alignment of the buffer is that of a pointer rather than that of
+// `std::aligned_storage_t<SIZE>`, so that the storage packs tightly next to the
+// vtable pointer in a `Poly`; more strictly aligned objects spill to the heap.
+template <
+	std::size_t SIZE,
+	std::size_t ALIGN = alignof(void*),
+	class Allocator = MallocAllocator
+	>
+class CompactSBOStorage :
+	public detail::SBOBase<detail::BareSlot<SIZE, ALIGN>, detail::AllocatorHeap<Allocator>>
+{
+public:
+
+	static_assert(SIZE >= sizeof(void*),
+		"caramel::poly::CompactSBOStorage: SIZE must leave room for a heap pointer");
+	static_assert(ALIGN >= alignof(void*),
+		"caramel::poly::CompactSBOStorage: ALIGN must be at least the alignment of a pointer");
+
+	CompactSBOStorage() = delete;
+	CompactSBOStorage(const CompactSBOStorage&) = delete;
+	CompactSBOStorage(CompactSBOStorage&&) = delete;
+	CompactSBOStorage& operator=(CompactSBOStorage&&) = delete;
+	CompactSBOStorage& operator=(const CompactSBOStorage&) = delete;
+
+	template <class T>
+	explicit CompactSBOStorage(T&& t) :
+		Base{ std::allocator_arg, detail::AllocatorHeap<Allocator>{}, std::forward<T>(t) }
+	{
+	}
+
+	template <class VTable>
+	CompactSBOStorage(const CompactSBOStorage& other, const VTable& vtable) :
+		Base{ other, vtable }
+	{
+	}
+
+	template <class VTable>
+	CompactSBOStorage(CompactSBOStorage&& other, const VTable& vtable) :
+		Base{ std::move(other), vtable }
+	{
+	}
+
+private:
+
+	using Base = typename CompactSBOStorage::SBOBase;
+
+};
+
+// Class implementing the small buffer optimization for over-aligned types.
+//
+// This is like `SBOStorage`, but objects whose alignment exceeds that of the
+// storage itself can still be stored inline, up to `MAX_ALIGN`: the object is
+// constructed at an aligned offset within a padded buffer (see
+// `detail::OverAlignedBuffer`), so the storage doesn't impose `MAX_ALIGN` on
+// whatever contains it. Finding the object costs an add and a mask.
+//
+// Objects spilled to the heap get the alignment provided by `Allocator`,
+// normally that of `std::max_align_t`.
+template <
+	std::size_t SIZE,
+	std::size_t MAX_ALIGN = 32,
+	class Allocator = MallocAllocator
+	>
+class AlignedSBOStorage :
+	public detail::SBOBase<
+		detail::FlaggedSlot<detail::OverAlignedBuffer<SIZE, MAX_ALIGN>>,
+		detail::AllocatorHeap<Allocator>
+		>
+{
+public:
+
+	AlignedSBOStorage() = delete;
+	AlignedSBOStorage(const AlignedSBOStorage&) = delete;
+	AlignedSBOStorage(AlignedSBOStorage&&) = delete;
+	AlignedSBOStorage& operator=(AlignedSBOStorage&&) = delete;
+	AlignedSBOStorage& operator=(const AlignedSBOStorage&) = delete;
+
+	template <class T, class RawT = std::decay_t<T>>
+	explicit AlignedSBOStorage(T&& t) :
+		Base{ std::allocator_arg, detail::AllocatorHeap<Allocator>{}, std::forward<T>(t) }
+	{
+		static_assert(
+			Base::canStore(caramel::poly::storageInfoFor<RawT>) || alignof(RawT) <= alignof(std::max_align_t),
+			"caramel::poly::AlignedSBOStorage: Over-aligned objects must fit in the buffer.");
+	}
+
+	template <class VTable>
+	AlignedSBOStorage(const AlignedSBOStorage& other, const VTable& vtable) :
+		Base{ other, vtable }
+	{
+	}
+
+	template <class VTable>
+	AlignedSBOStorage(AlignedSBOStorage&& other, const VTable& vtable) :
+		Base{ std::move(other), vtable }
+	{
+	}
+
+private:
+
+	using Base = typename AlignedSBOStorage::SBOBase;
+
+};
+
+// Class implementing storage on the heap. Just like the `SBOStorage`, it
+// only handles allocation and deallocation; construction and destruction
+// must be handled externally.
+template <class Allocator = MallocAllocator>
+struct RemoteStorage :
+	public detail::SBOBase<detail::HeapSlot, detail::AllocatorHeap<Allocator>>
+{
+	RemoteStorage() = delete;
+	RemoteStorage(const RemoteStorage&) = delete;
+	RemoteStorage(RemoteStorage&&) = delete;
+	RemoteStorage& operator=(RemoteStorage&&) = delete;
+	RemoteStorage& operator=(const RemoteStorage&) = delete;
+
+	template <class T>
+	explicit RemoteStorage(T&& t) :
+		Base{ std::allocator_arg, detail::AllocatorHeap<Allocator>{}, std::forward<T>(t) }
+	{
+	}
+
+	template <class VTable>
+	RemoteStorage(const RemoteStorage& other, const VTable& vtable) :
+		Base{ other, vtable }
+	{
+	}
+
+	template <class VTable>
+	RemoteStorage(RemoteStorage&& other, const VTable& vtable) noexcept :
+		Base{ std::move(other), vtable }
+	{
+	}
+
+private:
+
+	using Base = typename RemoteStorage::SBOBase;
+
+};
+
+// Class implementing storage on the heap, like `RemoteStorage`, but allocating
+// from a `std::pmr::memory_resource` chosen per instance rather than from a
+// static allocator policy.
+//
+// The resource is passed through the `std::allocator_arg_t` constructor and
+// defaults to `std::pmr::get_default_resource()`. It sticks to the allocation
+// it was used for: copies allocate from the source's resource, and moves and
+// swaps carry the resource along with the pointer, so memory is always given
+// back to the resource it came from. The resource must outlive the storage.
+struct PmrRemoteStorage :
+	public detail::SBOBase<detail::HeapSlot, detail::PmrHeap>
+{
+	PmrRemoteStorage() = delete;
+	PmrRemoteStorage(const PmrRemoteStorage&) = delete;
+	PmrRemoteStorage(PmrRemoteStorage&&) = delete;
+	PmrRemoteStorage& operator=(PmrRemoteStorage&&) = delete;
+	PmrRemoteStorage& operator=(const PmrRemoteStorage&) = delete;
+
+	template <class T>
+	explicit PmrRemoteStorage(T&& t) :
+		PmrRemoteStorage{ std::allocator_arg, std::pmr::get_default_resource(), std::forward<T>(t) }
+	{
+	}
+
+	template <class T>
+	PmrRemoteStorage(std::allocator_arg_t, std::pmr::memory_resource* resource, T&& t) :
+		Base{ std::allocator_arg, detail::PmrHeap{ resource }, std::forward<T>(t) }
+	{
+	}
+
+	template <class VTable>
+	PmrRemoteStorage(const PmrRemoteStorage& other, const VTable& vtable) :
+		Base{ other, vtable }
+	{
+	}
+
+	template <class VTable>
+	PmrRemoteStorage(PmrRemoteStorage&& other, const VTable& vtable) noexcept :
+		Base{ std::move(other), vtable }
+	{
+	}
+
+	std::pmr::memory_resource* resource() const {
+		return heap().resource;
+	}
+
+private:
+
+	using Base = SBOBase;
+
+};
+
+// Class implementing the small buffer optimization with heap-spilled objects
+// allocated from a `std::pmr::memory_resource`. Resource handling follows
+// `PmrRemoteStorage`; objects kept in the small buffer don't use the resource,
+// but still remember it so that their copies and swaps behave the same.
+template <
+	std::size_t SIZE,
+	std::size_t ALIGN = static_cast<std::size_t>(-1)
+	>
+class PmrSBOStorage :
+	public detail::SBOBase<
+		detail::FlaggedSlot<detail::AlignedBuffer<std::max(SIZE, sizeof(void*)), ALIGN>>,
+		detail::PmrHeap
+		>
+{
 public:
 
-	static constexpr std::size_t SBSIZE = (SIZE < sizeof(void*)) ? sizeof(void*) : SIZE;
-	static constexpr std::size_t SBALIGN =
-		(ALIGN == static_cast<std::size_t>(-1)) ? alignof(std::aligned_storage_t<SBSIZE>) : ALIGN;
+	PmrSBOStorage() = delete;
+	PmrSBOStorage(const PmrSBOStorage&) = delete;
+	PmrSBOStorage(PmrSBOStorage&&) = delete;
+	PmrSBOStorage& operator=(PmrSBOStorage&&) = delete;
+	PmrSBOStorage& operator=(const PmrSBOStorage&) = delete;
 
-	SBOStorage() = delete;
-	SBOStorage(const SBOStorage&) = delete;
-	SBOStorage(SBOStorage&&) = delete;
-	SBOStorage& operator=(SBOStorage&&) = delete;
-	SBOStorage& operator=(const SBOStorage&) = delete;
+	template <class T>
+	explicit PmrSBOStorage(T&& t) :
+		PmrSBOStorage{ std::allocator_arg, std::pmr::get_default_resource(), std::forward<T>(t) }
+	{
+	}
 
-	template <class T, class RawT = std::decay_t<T>>
-	explicit SBOStorage(T&& t) {
-		// TODO: We could also construct the object at an aligned address within
-		// the buffer, which would require computing the right address everytime
-		// we access the buffer as a T, but would allow more Ts to fit in the SBO.
-		if constexpr (canStore(caramel::poly::storageInfoFor<RawT>)) {
-			usesHeap_ = false;
-			new (&sb_) RawT(std::forward<T>(t));
-		} else {
-			usesHeap_ = true;
-			ptr_ = Allocator::allocate(sizeof(RawT));
-			// TODO: Allocating and then calling the constructor is not
-			//       exception-safe if the constructor throws.
-			// TODO: That's not a really nice way to handle this
-			assert(ptr_ != nullptr && "Memory allocation failed, we're doomed");
-			new (ptr_) RawT(std::forward<T>(t));
-		}
+	template <class T>
+	PmrSBOStorage(std::allocator_arg_t, std::pmr::memory_resource* resource, T&& t) :
+		Base{ std::allocator_arg, detail::PmrHeap{ resource }, std::forward<T>(t) }
+	{
 	}
 
 	template <class VTable>
-	SBOStorage(const SBOStorage& other, const VTable& vtable) {
-		if (other.usesHeap_) {
-			auto info = vtable[STORAGE_INFO_LABEL]();
-			usesHeap_ = true;
-			ptr_ = Allocator::allocate(info.size);
-			// TODO: That's not a really nice way to handle this
-			assert(ptr_ != nullptr && "Memory allocation failed, we're doomed");
-			vtable[COPY_CONSTRUCT_LABEL](ptr_, other.get());
-		} else {
-			usesHeap_ = false;
-			vtable[COPY_CONSTRUCT_LABEL](&sb_, other.get());
-		}
+	PmrSBOStorage(const PmrSBOStorage& other, const VTable& vtable) :
+		Base{ other, vtable }
+	{
 	}
 
 	template <class VTable>
-	SBOStorage(SBOStorage&& other, const VTable& vtable) :
-		usesHeap_{other.usesHeap_}
+	PmrSBOStorage(PmrSBOStorage&& other, const VTable& vtable) :
+		Base{ std::move(other), vtable }
 	{
-		if (usesHeap_) {
-			this->ptr_ = other.ptr_;
-			other.ptr_ = nullptr;
-		} else {
-			vtable[MOVE_CONSTRUCT_LABEL](this->get(), other.get());
-		}
 	}
 
-	template <class ThisVTable, class OtherVTable>
-	void swap(const ThisVTable& thisVTable, SBOStorage& other, const OtherVTable& otherVTable) {
-		if (this == &other) {
-			return;
-		}
+	std::pmr::memory_resource* resource() const {
+		return this->heap().resource;
+	}
 
-		if (this->usesHeap_) {
-			if (other.usesHeap_) {
-				using std::swap;
-				swap(this->ptr_, other.ptr_);
-			} else {
-				void* ptr = this->ptr_;
+private:
 
-				// Bring `other`'s contents to `*this`, destructively
-				otherVTable[MOVE_CONSTRUCT_LABEL](&this->sb_, &other.sb_);
-				otherVTable[DESTRUCT_LABEL](&other.sb_);
-				this->usesHeap_ = false;
+	using Base = typename PmrSBOStorage::SBOBase;
 
-				// Bring `*this`'s stuff to `other`
-				other.ptr_ = ptr;
-				other.usesHeap_ = true;
-			}
-		} else {
-			if (other.usesHeap_) {
-				void *ptr = other.ptr_;
+};
 
-				// Bring `*this`'s contents to `other`, destructively
-				thisVTable[MOVE_CONSTRUCT_LABEL](&other.sb_, &this->sb_);
-				thisVTable[DESTRUCT_LABEL](&this->sb_);
-				other.usesHeap_ = false;
+// Class implementing shared remote storage.
+//
+// This is basically the same as using a `std::shared_ptr` to store the
+// polymorphic object.
+//
+// TODO:
+// - Using `std::shared_ptr` in the implementation is suboptimal, because it
+//   reimplements type erasure for the deleter, but we could really reuse our
+//   vtable instead. `IntrusiveSharedRemoteStorage` does.
+// #TODO_Caramel: I want to implement my own shared ptr at some point, maybe replace
+// std::shared_ptr with it then?
+// - For remote storage policies, should it be possible to specify whether the
+//   pointed-to storage is const?
+template <class Allocator = MallocAllocator>
+struct SharedRemoteStorage {
+	SharedRemoteStorage() = delete;
+	SharedRemoteStorage(const SharedRemoteStorage&) = delete;
+	SharedRemoteStorage(SharedRemoteStorage&&) = delete;
+	SharedRemoteStorage& operator=(SharedRemoteStorage&&) = delete;
+	SharedRemoteStorage& operator=(const SharedRemoteStorage&) = delete;
 
-				// Bring `other`'s stuff to `*this`
-				this->ptr_ = ptr;
-				this->usesHeap_ = true;
+	template <class T, class RawT = std::decay_t<T>>
+	explicit SharedRemoteStorage(T&& t) :
+		ptr_{Allocator::template makeShared<RawT>(std::forward<T>(t))}
+	{
+	}
 
-			} else {
-				// Move `other` into temporary local storage, destructively.
-				SBStorage tmp;
-				otherVTable[MOVE_CONSTRUCT_LABEL](&tmp, &other.sb_);
-				otherVTable[DESTRUCT_LABEL](&other.sb_);
-
-				// Move `*this` into `other`, destructively.
-				thisVTable[MOVE_CONSTRUCT_LABEL](&other.sb_, &this->sb_);
-				thisVTable[DESTRUCT_LABEL](&this->sb_);
-
-				// Now, bring `tmp` into `*this`, destructively.
-				otherVTable[MOVE_CONSTRUCT_LABEL](&this->sb_, &tmp);
-				otherVTable[DESTRUCT_LABEL](&tmp);
-			}
-		}
+	template <class VTable>
+	SharedRemoteStorage(const SharedRemoteStorage& other, const VTable&) :
+		ptr_{other.ptr_}
+	{
 	}
 
 	template <class VTable>
-	void destruct(const VTable& vtable) {
-		if (usesHeap_) {
-			// If we've been moved from, don't do anything.
-			if (ptr_ == nullptr)
-				return;
+	SharedRemoteStorage(SharedRemoteStorage&& other, const VTable&) noexcept :
+		ptr_{std::move(other.ptr_)}
+	{
+	}
 
-			vtable[DESTRUCT_LABEL](ptr_);
-			Allocator::free(ptr_);
-		} else {
-			vtable[DESTRUCT_LABEL](&sb_);
-		}
+	template <class ThisVTable, class OtherVTable>
+	void swap(const ThisVTable&, SharedRemoteStorage& other, const OtherVTable&) noexcept {
+		using std::swap;
+		swap(this->ptr_, other.ptr_);
+	}
+
+	template <class VTable>
+	void destruct(const VTable&) {
+		ptr_.reset();
 	}
 
 	template <class T = void>
 	T* get() {
-		return static_cast<T*>(usesHeap_ ? ptr_ : &sb_);
+		return static_cast<T*>(ptr_.get());
 	}
 
 	template <class T = void>
 	const T* get() const {
-		return static_cast<const T*>(usesHeap_ ? ptr_ : &sb_);
+		return static_cast<const T*>(ptr_.get());
 	}
 
 private:
 
-	using SBStorage = std::aligned_storage_t<SBSIZE, SBALIGN>;
-
-	union {
-		void* ptr_;
-		SBStorage sb_;
-	};
-
-	// TODO: It might be possible to pack this bool inside the union somehow.
-	bool usesHeap_;
-
-	static constexpr bool canStore(caramel::poly::StorageInfo info) {
-		return (info.size <= SBSIZE) && (SBALIGN % info.alignment == 0);
-	}
+	std::shared_ptr<void> ptr_;
 
 };
 
-// Class implementing storage on the heap. Just like the `SBOStorage`, it
-// only handles allocation and deallocation; construction and destruction
-// must be handled externally.
-template <class Allocator = MallocAllocator>
-struct RemoteStorage {
-	RemoteStorage() = delete;
-	RemoteStorage(const RemoteStorage&) = delete;
-	RemoteStorage(RemoteStorage&&) = delete;
-	RemoteStorage& operator=(RemoteStorage&&) = delete;
-	RemoteStorage& operator=(const RemoteStorage&) = delete;
+// Class implementing shared remote storage with an intrusive reference count.
+//
+// The reference count lives in a header in front of the object, in the same
+// allocation, and the object is destroyed through the vtable's destructor
+// rather than through a type-erased deleter. Copying the storage only bumps the
+// count. `RefCount` selects between `AtomicRefCount` (the default) and
+// `NonAtomicRefCount` for objects that are never shared between threads.
+template <class RefCount = AtomicRefCount, class Allocator = MallocAllocator>
+struct IntrusiveSharedRemoteStorage {
+	IntrusiveSharedRemoteStorage() = delete;
+	IntrusiveSharedRemoteStorage(const IntrusiveSharedRemoteStorage&) = delete;
+	IntrusiveSharedRemoteStorage(IntrusiveSharedRemoteStorage&&) = delete;
+	IntrusiveSharedRemoteStorage& operator=(IntrusiveSharedRemoteStorage&&) = delete;
+	IntrusiveSharedRemoteStorage& operator=(const IntrusiveSharedRemoteStorage&) = delete;
 
 	template <class T, class RawT = std::decay_t<T>>
-	explicit RemoteStorage(T&& t) :
-		ptr_{Allocator::allocate(sizeof(RawT))}
-	{
-		// TODO: That's not a really nice way to handle this
-		assert(ptr_ != nullptr && "Memory allocation failed, we're doomed");
+	explicit IntrusiveSharedRemoteStorage(T&& t) {
+		static_assert(alignof(RawT) <= alignof(Header),
+			"caramel::poly::IntrusiveSharedRemoteStorage: Over-aligned objects are not supported.");
+
+		auto* header = static_cast<Header*>(Allocator::allocate(sizeof(Header) + sizeof(RawT)));
+		if (header == nullptr) {
+			throw std::bad_alloc();
+		}
 
-		new (ptr_) RawT(std::forward<T>(t));
+		new (header) Header();
+		try {
+			ptr_ = new (header + 1) RawT(std::forward<T>(t));
+		} catch (...) {
+			header->~Header();
+			Allocator::free(header);
+			throw;
+		}
 	}
 
 	template <class VTable>
-	RemoteStorage(const RemoteStorage& other, const VTable& vtable) :
-		ptr_{Allocator::allocate(vtable[STORAGE_INFO_LABEL]().size)}
+	IntrusiveSharedRemoteStorage(const IntrusiveSharedRemoteStorage& other, const VTable&) :
+		ptr_{other.ptr_}
 	{
-		// TODO: That's not a really nice way to handle this
-		assert(ptr_ != nullptr && "Memory allocation failed, we're doomed");
-
-		vtable[COPY_CONSTRUCT_LABEL](this->get(), other.get());
+		if (ptr_ != nullptr) {
+			header()->refCount.acquire();
+		}
 	}
 
 	template <class VTable>
-	RemoteStorage(RemoteStorage&& other, const VTable&) :
+	IntrusiveSharedRemoteStorage(IntrusiveSharedRemoteStorage&& other, const VTable&) noexcept :
 		ptr_{other.ptr_}
 	{
 		other.ptr_ = nullptr;
 	}
 
 	template <class ThisVTable, class OtherVTable>
-	void swap(const ThisVTable&, RemoteStorage& other, const OtherVTable&) {
-		std::swap(this->ptr_, other.ptr_);
+	void swap(const ThisVTable&, IntrusiveSharedRemoteStorage& other, const OtherVTable&) noexcept {
+		using std::swap;
+		swap(this->ptr_, other.ptr_);
 	}
 
 	template <class VTable>
@@ -324,8 +1217,13 @@ struct RemoteStorage {
 			return;
 		}
 
-		vtable[DESTRUCT_LABEL](ptr_);
-		Allocator::free(ptr_);
+		auto* h = header();
+		if (h->refCount.release()) {
+			detail::destroy(vtable, ptr_);
+			h->~Header();
+			Allocator::free(h);
+		}
+		ptr_ = nullptr;
 	}
 
 	template <class T = void>
@@ -338,75 +1236,176 @@ struct RemoteStorage {
 		return static_cast<const T*>(ptr_);
 	}
 
+	// Number of storages sharing the object, or zero if moved from.
+	std::size_t useCount() const {
+		return (ptr_ == nullptr) ? 0 : header()->refCount.count();
+	}
+
+	static constexpr bool canStore(caramel::poly::StorageInfo info) {
+		return info.alignment <= alignof(Header);
+	}
+
 private:
 
+	// The size of the header is a multiple of its alignment, so the object
+	// following it is aligned like any object returned by `Allocator`.
+	struct alignas(std::max_align_t) Header {
+		RefCount refCount;
+	};
+
 	void* ptr_;
 
+	Header* header() const {
+		return static_cast<Header*>(ptr_) - 1;
+	}
+
 };
 
-// Class implementing shared remote storage.
+// Class implementing copy-on-write storage.
 //
-// This is basically the same as using a `std::shared_ptr` to store the
-// polymorphic object.
+// Like `IntrusiveSharedRemoteStorage`, copies share the object and only bump
+// its reference count. However, an object is never modified while shared:
+// mutable access through `get(vtable)` first gives the storage its own copy of
+// the object, made through the vtable's `COPY_CONSTRUCT_LABEL`, if anybody else
+// refers to it. `Poly` does this for non-const methods, non-const placeholder
+// arguments and the non-const `unsafeGet`, so values stored in a `Poly` keep
+// their usual value semantics. The concept must therefore be copy
+// constructible.
 //
-// TODO:
-// - Using `std::shared_ptr` in the implementation is suboptimal, because it
-//   reimplements type erasure for the deleter, but we could really reuse our
-//   vtable instead.
-// #TODO_Caramel: I want to implement my own shared ptr at some point, maybe replace
-// std::shared_ptr with it then?
-// - For remote storage policies, should it be possible to specify whether the
-//   pointed-to storage is const?
-template <class Allocator = MallocAllocator>
-struct SharedRemoteStorage {
-	SharedRemoteStorage() = delete;
-	SharedRemoteStorage(const SharedRemoteStorage&) = delete;
-	SharedRemoteStorage(SharedRemoteStorage&&) = delete;
-	SharedRemoteStorage& operator=(SharedRemoteStorage&&) = delete;
-	SharedRemoteStorage& operator=(const SharedRemoteStorage&) = delete;
+// Note that the plain non-const `get()` does not unshare the object.
+template <class RefCount = AtomicRefCount, class Allocator = MallocAllocator>
+struct CowStorage {
+	CowStorage() = delete;
+	CowStorage(const CowStorage&) = delete;
+	CowStorage(CowStorage&&) = delete;
+	CowStorage& operator=(CowStorage&&) = delete;
+	CowStorage& operator=(const CowStorage&) = delete;
 
 	template <class T, class RawT = std::decay_t<T>>
-	explicit SharedRemoteStorage(T&& t) :
-		ptr_{Allocator::template makeShared<RawT>(std::forward<T>(t))}
-	{
+	explicit CowStorage(T&& t) {
+		static_assert(alignof(RawT) <= alignof(Header),
+			"caramel::poly::CowStorage: Over-aligned objects are not supported.");
+
+		auto* header = allocate(sizeof(RawT));
+		try {
+			ptr_ = new (header + 1) RawT(std::forward<T>(t));
+		} catch (...) {
+			deallocate(header);
+			throw;
+		}
 	}
 
 	template <class VTable>
-	SharedRemoteStorage(const SharedRemoteStorage& other, const VTable&) :
+	CowStorage(const CowStorage& other, const VTable&) :
 		ptr_{other.ptr_}
 	{
+		if (ptr_ != nullptr) {
+			header()->refCount.acquire();
+		}
 	}
 
 	template <class VTable>
-	SharedRemoteStorage(SharedRemoteStorage&& other, const VTable&) :
-		ptr_{std::move(other.ptr_)}
+	CowStorage(CowStorage&& other, const VTable&) noexcept :
+		ptr_{other.ptr_}
 	{
+		other.ptr_ = nullptr;
 	}
 
 	template <class ThisVTable, class OtherVTable>
-	void swap(const ThisVTable&, SharedRemoteStorage& other, const OtherVTable&) {
+	void swap(const ThisVTable&, CowStorage& other, const OtherVTable&) noexcept {
 		using std::swap;
 		swap(this->ptr_, other.ptr_);
 	}
 
 	template <class VTable>
-	void destruct(const VTable&) {
-		ptr_.reset();
+	void destruct(const VTable& vtable) {
+		// If we've been moved from, don't do anything.
+		if (ptr_ == nullptr) {
+			return;
+		}
+
+		release(header(), vtable);
+		ptr_ = nullptr;
 	}
 
 	template <class T = void>
 	T* get() {
-		return static_cast<T*>(ptr_.get());
+		return static_cast<T*>(ptr_);
 	}
 
 	template <class T = void>
 	const T* get() const {
-		return static_cast<const T*>(ptr_.get());
+		return static_cast<const T*>(ptr_);
+	}
+
+	template <class T = void, class VTable>
+	T* get(const VTable& vtable) {
+		if (ptr_ != nullptr && header()->refCount.count() != 1) {
+			unshare(vtable);
+		}
+		return static_cast<T*>(ptr_);
+	}
+
+	// Number of storages sharing the object, or zero if moved from.
+	std::size_t useCount() const {
+		return (ptr_ == nullptr) ? 0 : header()->refCount.count();
+	}
+
+	static constexpr bool canStore(caramel::poly::StorageInfo info) {
+		return info.alignment <= alignof(Header);
 	}
 
 private:
 
-	std::shared_ptr<void> ptr_;
+	// The size of the header is a multiple of its alignment, so the object
+	// following it is aligned like any object returned by `Allocator`.
+	struct alignas(std::max_align_t) Header {
+		RefCount refCount;
+	};
+
+	void* ptr_;
+
+	Header* header() const {
+		return static_cast<Header*>(ptr_) - 1;
+	}
+
+	static Header* allocate(std::size_t size) {
+		auto* header = static_cast<Header*>(Allocator::allocate(sizeof(Header) + size));
+		if (header == nullptr) {
+			throw std::bad_alloc();
+		}
+		return new (header) Header();
+	}
+
+	// Gives back a header whose object was never constructed.
+	static void deallocate(Header* header) {
+		header->~Header();
+		Allocator::free(header);
+	}
+
+	template <class VTable>
+	static void release(Header* header, const VTable& vtable) {
+		if (header->refCount.release()) {
+			detail::destroy(vtable, header + 1);
+			deallocate(header);
+		}
+	}
+
+	template <class VTable>
+	void unshare(const VTable& vtable) {
+		auto* shared = header();
+		auto* copy = allocate(vtable[STORAGE_INFO_LABEL].size);
+		try {
+			vtable[COPY_CONSTRUCT_LABEL](copy + 1, ptr_);
+		} catch (...) {
+			deallocate(copy);
+			throw;
+		}
+		ptr_ = copy + 1;
+
+		// The other owners may have let go of the object in the meantime.
+		release(shared, vtable);
+	}
 
 };
 
@@ -420,7 +1419,9 @@ template <
 	std::size_t SIZE,
 	std::size_t ALIGN = static_cast<std::size_t>(-1)
 	>
-class LocalStorage {
+class LocalStorage :
+	public detail::SBOBase<detail::InlineSlot<detail::AlignedBuffer<SIZE, ALIGN>>, detail::NoHeap>
+{
 public:
 	LocalStorage() = delete;
 	LocalStorage(const LocalStorage&) = delete;
@@ -429,86 +1430,79 @@ public:
 	LocalStorage& operator=(const LocalStorage&) = delete;
 
 	template <class T, class RawT = std::decay_t<T>>
-	explicit LocalStorage(T&& t) {
-		// TODO: We could also construct the object at an aligned address within
-		// the buffer, which would require computing the right address everytime
-		// we access the buffer as a T, but would allow more Ts to fit inside it.
-		static_assert(canStore(caramel::poly::storageInfoFor<RawT>),
+	explicit LocalStorage(T&& t) :
+		Base{ std::allocator_arg, detail::NoHeap{}, std::forward<T>(t) }
+	{
+		static_assert(Base::canStore(caramel::poly::storageInfoFor<RawT>),
 			"caramel::poly::LocalStorage: Trying to construct from an object that won't fit "
 			"in the local storage."
 			);
-
-		new (&buffer_) RawT(std::forward<T>(t));
 	}
 
 	template <class VTable>
-	LocalStorage(const LocalStorage& other, const VTable& vtable) {
-		assert(canStore(vtable[STORAGE_INFO_LABEL]()) &&
-			"caramel::poly::LocalStorage: Trying to copy-construct using a vtable that "
-			"describes an object that won't fit in the storage.");
-
-		vtable[COPY_CONSTRUCT_LABEL](this->get(), other.get());
+	LocalStorage(const LocalStorage& other, const VTable& vtable) :
+		Base{ other, vtable }
+	{
 	}
 
 	template <class VTable>
-	LocalStorage(LocalStorage&& other, const VTable& vtable) {
-		assert(canStore(vtable[STORAGE_INFO_LABEL]()) &&
-			"caramel::poly::LocalStorage: Trying to move-construct using a vtable that "
-			"describes an object that won't fit in the storage.");
-
-		vtable[MOVE_CONSTRUCT_LABEL](this->get(), other.get());
+	LocalStorage(LocalStorage&& other, const VTable& vtable) :
+		Base{ std::move(other), vtable }
+	{
 	}
 
-	template <class ThisVTable, class OtherVTable>
-	void swap(const ThisVTable& thisVTable, LocalStorage& other, const OtherVTable& otherVTable) {
-		if (this == &other) {
-			return;
-		}
+private:
 
-		// Move `other` into temporary local storage, destructively.
-		Buffer tmp;
-		otherVTable[MOVE_CONSTRUCT_LABEL](&tmp, &other.buffer_);
-		otherVTable[DESTRUCT_LABEL](&other.buffer_);
+	using Base = typename LocalStorage::SBOBase;
 
-		// Move `*this` into `other`, destructively.
-		thisVTable[MOVE_CONSTRUCT_LABEL](&other.buffer_, &this->buffer_);
-		thisVTable[DESTRUCT_LABEL](&this->buffer_);
+};
 
-		// Now, bring `tmp` into `*this`, destructively.
-		otherVTable[MOVE_CONSTRUCT_LABEL](&this->buffer_, &tmp);
-		otherVTable[DESTRUCT_LABEL](&tmp);
-	}
+// A `LocalStorage` that fits an object of any of `Ts`, for use with the
+// `Sealed<Ts...>` vtable policy.
+template <class... Ts>
+using SealedStorage = LocalStorage<std::max({ sizeof(Ts)... }), std::max({ alignof(Ts)... })>;
 
-	template <class VTable>
-	void destruct(const VTable& vtable) {
-		vtable[DESTRUCT_LABEL](&buffer_);
-	}
+// Class implementing unconditional storage in a local buffer for over-aligned
+// types. This is to `LocalStorage` what `AlignedSBOStorage` is to `SBOStorage`.
+template <
+	std::size_t SIZE,
+	std::size_t MAX_ALIGN = 32
+	>
+class AlignedLocalStorage :
+	public detail::SBOBase<detail::InlineSlot<detail::OverAlignedBuffer<SIZE, MAX_ALIGN>>, detail::NoHeap>
+{
+public:
+	AlignedLocalStorage() = delete;
+	AlignedLocalStorage(const AlignedLocalStorage&) = delete;
+	AlignedLocalStorage(AlignedLocalStorage&&) = delete;
+	AlignedLocalStorage& operator=(AlignedLocalStorage&&) = delete;
+	AlignedLocalStorage& operator=(const AlignedLocalStorage&) = delete;
 
-	template <class T = void>
-	T* get() {
-		return static_cast<T*>(static_cast<void*>(&buffer_));
+	template <class T, class RawT = std::decay_t<T>>
+	explicit AlignedLocalStorage(T&& t) :
+		Base{ std::allocator_arg, detail::NoHeap{}, std::forward<T>(t) }
+	{
+		static_assert(Base::canStore(caramel::poly::storageInfoFor<RawT>),
+			"caramel::poly::AlignedLocalStorage: Trying to construct from an object that won't fit "
+			"in the local storage."
+			);
 	}
 
-	template <class T = void>
-	const T* get() const {
-		return static_cast<const T*>(static_cast<const void*>(&buffer_));
+	template <class VTable>
+	AlignedLocalStorage(const AlignedLocalStorage& other, const VTable& vtable) :
+		Base{ other, vtable }
+	{
 	}
 
-	static constexpr bool canStore(caramel::poly::StorageInfo info) {
-		return
-			info.size <= sizeof(Buffer) &&
-			alignof(Buffer) % info.alignment == 0
-			;
+	template <class VTable>
+	AlignedLocalStorage(AlignedLocalStorage&& other, const VTable& vtable) :
+		Base{ std::move(other), vtable }
+	{
 	}
 
 private:
 
-	using Buffer = std::aligned_storage_t<
-		SIZE,
-		ALIGN == static_cast<size_t>(-1) ? alignof(std::aligned_storage_t<SIZE>) : ALIGN
-		>;
-	
-	Buffer buffer_;
+	using Base = typename AlignedLocalStorage::SBOBase;
 
 };
 
@@ -529,6 +1523,12 @@ struct NonOwningStorage {
 	{
 	}
 
+	// Refers to the object at `object`, whatever its type.
+	NonOwningStorage(std::in_place_t, void* object) :
+		ptr_{object}
+	{
+	}
+
 	template <class VTable>
 	NonOwningStorage(const NonOwningStorage& other, const VTable&) :
 		ptr_{other.ptr_}
@@ -536,13 +1536,13 @@ struct NonOwningStorage {
 	}
 
 	template <class VTable>
-	NonOwningStorage(NonOwningStorage&& other, const VTable&) :
+	NonOwningStorage(NonOwningStorage&& other, const VTable&) noexcept :
 		ptr_{other.ptr_}
 	{
 	}
 
 	template <class ThisVTable, class OtherVTable>
-	void swap(const ThisVTable&, NonOwningStorage& other, const OtherVTable&) {
+	void swap(const ThisVTable&, NonOwningStorage& other, const OtherVTable&) noexcept {
 		std::swap(this->ptr_, other.ptr_);
 	}
 
@@ -570,8 +1570,79 @@ private:
 
 };
 
+// Class implementing storage in a monotonic `Arena`.
+//
+// The object is bump-allocated from the arena passed to the constructor, and
+// copies are allocated from the same arena. Destroying the object runs its
+// destructor, but doesn't free its memory; that only happens in bulk when the
+// arena is reset or destroyed. The destructor call itself is skipped for
+// trivially destructible types.
+//
+// The arena must outlive every `ArenaStorage` allocated from it.
+class ArenaStorage :
+	public detail::SBOBase<detail::HeapSlot, detail::ArenaHeap>
+{
+public:
+	ArenaStorage() = delete;
+	ArenaStorage(const ArenaStorage&) = delete;
+	ArenaStorage(ArenaStorage&&) = delete;
+	ArenaStorage& operator=(ArenaStorage&&) = delete;
+	ArenaStorage& operator=(const ArenaStorage&) = delete;
+
+	template <class T>
+	ArenaStorage(std::allocator_arg_t, caramel::poly::Arena& arena, T&& t) :
+		Base{ std::allocator_arg, detail::ArenaHeap{ arena }, std::forward<T>(t) }
+	{
+	}
+
+	template <class VTable>
+	ArenaStorage(const ArenaStorage& other, const VTable& vtable) :
+		Base{ other, vtable }
+	{
+	}
+
+	template <class VTable>
+	ArenaStorage(ArenaStorage&& other, const VTable& vtable) noexcept :
+		Base{ std::move(other), vtable }
+	{
+	}
+
+	caramel::poly::Arena* arena() const {
+		return heap().arena();
+	}
+
+private:
+
+	using Base = SBOBase;
+
+};
+
 // #TODO_Caramel: dropped fallback storage, as I don't really see the need to have it. Copy it if necessary.
 
+// Storage classes only holding pointers to objects living elsewhere. The
+// control block of `std::shared_ptr` doesn't point back at the `shared_ptr`
+// objects in any standard library implementation we know of.
+template <class Allocator>
+constexpr bool isTriviallyRelocatable<RemoteStorage<Allocator>> = true;
+
+template <>
+constexpr bool isTriviallyRelocatable<PmrRemoteStorage> = true;
+
+template <class Allocator>
+constexpr bool isTriviallyRelocatable<SharedRemoteStorage<Allocator>> = true;
+
+template <class RefCount, class Allocator>
+constexpr bool isTriviallyRelocatable<IntrusiveSharedRemoteStorage<RefCount, Allocator>> = true;
+
+template <class RefCount, class Allocator>
+constexpr bool isTriviallyRelocatable<CowStorage<RefCount, Allocator>> = true;
+
+template <>
+constexpr bool isTriviallyRelocatable<NonOwningStorage> = true;
+
+template <>
+constexpr bool isTriviallyRelocatable<ArenaStorage> = true;
+
 } // namespace caramel::poly
 
 #endif /* CARAMELPOLY_STORAGE_HPP__ */
@@ -9,6 +9,16 @@
 #ifndef CARAMELPOLY_VTABLE_HPP__
 #define CARAMELPOLY_VTABLE_HPP__
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -49,11 +59,97 @@ namespace caramel::poly {
 //  Semantics: Return the function with the given name in the vtable if there
 //             is one. The behavior when no such function exists in the vtable
 //             is implementation defined (in most cases that's a compile-time
-//             error).
+//             error). For a constant clause (see `caramel::poly::constant`),
+//             return the value of the constant instead, or a pointer to it for
+//             a reference constant, and for a field clause (see
+//             `caramel::poly::field`), the offset of the field in the object.
+//
+// template <class Name> const void* sharedTable(Name) const;
+//  Semantics: Return the address of the table the function with the given
+//             name is read from, if that table is shared by all the vtables
+//             built from the same concept map, and a null pointer if the
+//             function is held in the vtable itself. This lets callers cache
+//             the result of a lookup per concept map (see `CallSiteCache`).
+//
+// template <class OtherTable> Table(detail::SliceTag, const OtherTable& other);
+//  Semantics: Construct a vtable holding the functions of the same names as
+//             `other`, a vtable for a concept that has all the clauses of
+//             the concept of `Table` (e.g. because it refines it). The
+//             functions are copied as they are, so calls through the new
+//             vtable go straight to the functions of `other`. Vtables
+//             referring to a shared table (see `detail::SharedTable`) may
+//             only be constructed so if `other` has a slice of that table.
+//
+// template <class Sliced> static constexpr bool hasSlice();
+// template <class Sliced> const Sliced* slice() const;
+//  Semantics: Return whether the vtable can give the shared table of type
+//             `Sliced` (a `detail::SharedTable`) built for the type of the
+//             object, and that table. `slice` is only called if it can.
 
 //////////////////////////////////////////////////////////////////////////////
 // Vtable implementations
 
+namespace detail {
+
+// Selects the constructors of vtables that build them from the functions of
+// another vtable (see the `VTable` concept).
+struct SliceTag {
+};
+
+// What a vtable holds for a clause, and how it is made from the function
+// given for the clause in a concept map: a pointer to the erased function,
+// the value of a constant (see `caramel::poly::constant`) or the offset of a
+// field (see `caramel::poly::field`).
+template <class Clause>
+struct VTableEntry {
+	using Type = typename EraseSignature<typename Clause::Type>::Type*;
+
+	template <class F>
+	static constexpr Type make(F f) {
+		return EraseFunction<typename Clause::Type>(f);
+	}
+};
+
+template <class T>
+struct VTableEntry<caramel::poly::Constant<T>> {
+	using Type = T;
+
+	template <class F>
+	static constexpr Type make(F f) {
+		return f();
+	}
+};
+
+template <class T>
+struct VTableEntry<caramel::poly::Constant<T&>> {
+	using Type = T*;
+
+	template <class F>
+	static constexpr Type make(F f) {
+		return &f();
+	}
+};
+
+template <class T>
+struct VTableEntry<caramel::poly::Field<T>> {
+	using Type = std::ptrdiff_t;
+
+	template <class F>
+	static constexpr Type make(F f) {
+		return f();
+	}
+};
+
+template <class Clause>
+struct VTableEntry<caramel::poly::Hot<Clause>> : VTableEntry<Clause> {
+};
+
+// Whether vtables hold a value for the clause rather than a function.
+template <class Clause>
+constexpr auto holdsValue = isConstant<Clause> || isField<Clause>;
+
+} // namespace detail
+
 // Class implementing a local vtable, i.e. a vtable whose storage is held
 // right where the `LocalVTable` is instantiated.
 template <class... Mappings>
@@ -70,7 +166,20 @@ struct LocalVTable<detail::ConstexprPair<Name, Clause>...> {
 			detail::makeConstexprMap(
 				detail::makeConstexprPair(
 					Name{},
-					detail::EraseFunction<typename Clause::Type>(map[Name{}])
+					detail::VTableEntry<Clause>::make(map[Name{}])
+					)...
+				)
+			}
+	{
+	}
+
+	template <class OtherVTable>
+	constexpr LocalVTable(detail::SliceTag, const OtherVTable& other) :
+		vtbl_{
+			detail::makeConstexprMap(
+				detail::makeConstexprPair(
+					Name{},
+					static_cast<typename detail::VTableEntry<Clause>::Type>(other[Name{}])
 					)...
 				)
 			}
@@ -100,7 +209,18 @@ struct LocalVTable<detail::ConstexprPair<Name, Clause>...> {
 		}
 	}
 
-	friend void swap(LocalVTable& lhs, LocalVTable& rhs) {
+	template <class OtherName>
+	constexpr const void* sharedTable(OtherName) const {
+		return nullptr;
+	}
+
+	// A local vtable holds no shared table to slice (see `RemoteVTable`).
+	template <class Sliced>
+	static constexpr bool hasSlice() {
+		return false;
+	}
+
+	friend void swap(LocalVTable& lhs, LocalVTable& rhs) noexcept {
 		forEach(
 			keys(lhs.vtbl_),
 			[&lhs, &rhs](auto key) {
@@ -113,10 +233,7 @@ struct LocalVTable<detail::ConstexprPair<Name, Clause>...> {
 private:
 
 	using FunctionMap = detail::ConstexprMap<
-		detail::ConstexprPair<
-			Name,
-			typename detail::EraseSignature<typename Clause::Type>::Type*
-			>...
+		detail::ConstexprPair<Name, typename detail::VTableEntry<Clause>::Type>...
 		>;
 
 	FunctionMap vtbl_;
@@ -125,21 +242,271 @@ private:
 
 namespace detail {
 
-template <class VTable, class ConceptMap>
-static const VTable STATIC_VTABLE{ ConceptMap{} };
+// The type modelled by a concept map.
+template <class ConceptMap>
+struct ModelOf;
+
+template <class Concept, class T, class... Mappings>
+struct ModelOf<caramel::poly::ConceptMap<Concept, T, Mappings...>> {
+	using Type = T;
+};
+
+// The default concept map of `T` for `Concept`, completed.
+template <class Concept, class T>
+using DefaultConceptMap = decltype(caramel::poly::completeConceptMap<Concept, T>(caramel::poly::conceptMap<Concept, T>));
+
+// The concept map to build the table for `Concept` sliced from a table built
+// from `map` with: the default concept map of the type for `Concept` if it
+// maps the same functions, so that the sliced table is the very table of the
+// objects of that type stored in polys of `Concept`, and `map` otherwise.
+template <class Concept, class ConceptMap>
+constexpr auto sliceMap([[maybe_unused]] ConceptMap map) {
+	using T = typename ModelOf<ConceptMap>::Type;
+	if constexpr (caramel::poly::models<Concept, T>) {
+		constexpr auto sameFunctions = allOf(clauseNames(Concept{}), [](auto name) {
+				return std::is_same_v<decltype(DefaultConceptMap<Concept, T>{}[name]), decltype(ConceptMap{}[name])>;
+			});
+		if constexpr (sameFunctions) {
+			return DefaultConceptMap<Concept, T>{};
+		} else {
+			return map;
+		}
+	} else {
+		return map;
+	}
+}
+
+template <class Concept, class ConceptMap>
+using SliceMap = decltype(sliceMap<Concept>(ConceptMap{}));
+
+// Whether the table of type `Table` built from `ConceptMap` is a constant
+// expression. It isn't if the concept map gives a constant with a lambda or
+// binds a field (see `caramel::poly::constant` and `caramel::poly::field`).
+template <class Table, class ConceptMap, class = void>
+constexpr bool isConstantTable = false;
+
+template <class Table, class ConceptMap>
+constexpr bool isConstantTable<Table, ConceptMap, std::enable_if_t<(Table{ ConceptMap{} }, true)>> = true;
+
+// The table of type `Table` (a `SharedTable`) built from `ConceptMap`, shared by
+// all the vtables referring to it, if it is constant (see `staticVTable`).
+template <class Table, class ConceptMap>
+static const Table STATIC_VTABLE{ ConceptMap{} };
+
+template <class Table, class ConceptMap>
+const Table& dynamicVTable() {
+	static const Table table{ ConceptMap{} };
+	return table;
+}
+
+// The address of the table of type `Table` built from `ConceptMap`. A constant
+// table is initialized before any code runs. Any other table would be
+// initialized dynamically, at some unspecified point of the initialization of
+// the program, so polys created before that, during the initialization of
+// other variables, would read its entries while they are still null. It is
+// built the first time it is needed instead, which costs a check each time.
+template <class Table, class ConceptMap>
+constexpr const Table* staticVTable() {
+	if constexpr (isConstantTable<Table, ConceptMap>) {
+		return &STATIC_VTABLE<Table, ConceptMap>;
+	} else {
+		return &dynamicVTable<Table, ConceptMap>();
+	}
+}
+
+// Assigns dense indices to the shared tables of type `Table`, in the order in
+// which they are first needed, and maps the indices back to the tables. A
+// table sliced from the table of another concept (see `SharedTable`) is
+// given its index by the function it holds, so it gets the index of the
+// table of the objects of the same type stored with `Table` directly when it
+// is that very table.
+//
+// The tables are held in an array that only ever grows. When it has to, the
+// entries are copied to a new array, and the old one is left alive for the
+// threads that may still be reading it. The arrays are never freed, so that
+// indices may be resolved during static destruction. Only giving a table its
+// index locks, once per table.
+template <class Table>
+class VTableRegistry {
+public:
+
+	template <class ConceptMap>
+	static std::size_t indexOf() {
+		static const auto index = add(*staticVTable<Table, ConceptMap>());
+		return index;
+	}
+
+	static const Table& at(std::size_t index) noexcept {
+		return *tables_.load(std::memory_order_acquire)[index];
+	}
+
+private:
+
+	static constexpr std::size_t INITIAL_CAPACITY = 64;
+
+	static inline std::mutex mutex_;
+
+	static inline std::atomic<const Table**> tables_{ nullptr };
+
+	static inline std::atomic<std::size_t> size_{ 0 };
+
+	static inline std::size_t capacity_ = 0;
+
+	static std::size_t add(const Table& table) {
+		const auto lock = std::lock_guard<std::mutex>(mutex_);
+		const auto size = size_.load(std::memory_order_relaxed);
+		auto* tables = tables_.load(std::memory_order_relaxed);
+		if (size == capacity_) {
+			const auto capacity = capacity_ == 0 ? INITIAL_CAPACITY : 2 * capacity_;
+			auto* grown = new const Table*[capacity];
+			std::copy_n(tables, size, grown);
+			tables_.store(grown, std::memory_order_release);
+			tables = grown;
+			capacity_ = capacity;
+		}
+		tables[size] = &table;
+		size_.store(size + 1, std::memory_order_release);
+		return size;
+	}
+
+};
+
+template <class VTable, class Concept>
+struct SharedTable;
+
+// The table sliced from a shared table holding the functions of `VTable` for
+// `SubConcept`, as a list of a null pointer to it, or an empty list if
+// `VTable` holds none of the functions of `SubConcept`. It holds them in the
+// order of `SubConcept`, as a `RemoteVTable` of `SubConcept` does.
+template <class VTable, class SubConcept>
+constexpr auto slicedTable(SubConcept subConcept) {
+	auto names = filter(clauseNames(subConcept), [](auto name) { return VTable{}.contains(name); });
+	if constexpr (empty(decltype(names){})) {
+		return makeConstexprList();
+	} else {
+		return unpack(names, [](auto... name) {
+				using Table = SharedTable<
+					LocalVTable<ConstexprPair<decltype(name), decltype(SubConcept{}.getSignature(name))>...>,
+					SubConcept
+					>;
+				return makeConstexprList(static_cast<const Table*>(nullptr));
+			});
+	}
+}
+
+template <class VTable, class Concept>
+constexpr auto slicedTables() {
+	return flatten(transform(subConcepts(Concept{}), [](auto subConcept) {
+			return slicedTable<VTable>(subConcept);
+		}));
+}
+
+// The distinct types of a list of pointers, as a tuple.
+template <class Pointers, class Unique = std::tuple<>>
+struct UniquePointers {
+	using Type = Unique;
+};
+
+template <class Pointer, class... Pointers, class... Unique>
+struct UniquePointers<ConstexprList<Pointer, Pointers...>, std::tuple<Unique...>> :
+	UniquePointers<
+		ConstexprList<Pointers...>,
+		std::conditional_t<(std::is_same_v<Pointer, Unique> || ...), std::tuple<Unique...>, std::tuple<Unique..., Pointer>>
+		>
+{
+};
+
+template <class Slices>
+struct SliceTables;
+
+template <class... Sliced>
+struct SliceTables<std::tuple<const Sliced*...>> {
+	template <class ConceptMap>
+	static constexpr std::tuple<const Sliced*...> of(ConceptMap) {
+		return { staticVTable<Sliced, SliceMap<typename Sliced::Concept, ConceptMap>>()... };
+	}
+};
+
+// A table of the functions of `VTable` (a `LocalVTable`) of a type, shared by
+// all the polys of `Concept` holding objects of that type, such as those
+// `RemoteVTable` and `IndexedVTable` refer to.
+//
+// It also points to the tables of the sub-concepts of `Concept` (see
+// `subConcepts`), such as the concepts of polys of the concepts refined by
+// that of the poly, built for the same type. The tables are constant and
+// built along with this table, so converting a poly to a poly of such a
+// concept (see `Poly`) costs a load at most, the table to use being known at
+// compile time. All the tables are thus built for every type stored in polys
+// of `Concept`, whether polys of the type are converted or not.
+template <class VTable, class ConceptT>
+struct SharedTable : VTable {
+
+	using Concept = ConceptT;
+
+	using Slices = typename UniquePointers<decltype(slicedTables<VTable, Concept>())>::Type;
+
+	template <class ConceptMap>
+	constexpr explicit SharedTable(ConceptMap map) :
+		VTable(map),
+		slices{SliceTables<Slices>::of(map)},
+		indexOf{&VTableRegistry<SharedTable>::template indexOf<ConceptMap>}
+	{
+	}
+
+	Slices slices;
+
+	// The index of the table in the registry of its type (see `IndexedVTable`).
+	std::size_t (*indexOf)();
+
+};
+
+template <class Pointer, class Pointers>
+constexpr bool isInTuple = false;
+
+template <class Pointer, class... Pointers>
+constexpr bool isInTuple<Pointer, std::tuple<Pointers...>> = (std::is_same_v<Pointer, Pointers> || ...);
+
+// Whether a table of type `Sliced` is sliced from the shared tables of type
+// `Table`, which includes the tables of type `Table` themselves.
+template <class Table, class Sliced>
+constexpr bool slicesTo = std::is_same_v<Table, Sliced> || isInTuple<const Sliced*, typename Table::Slices>;
+
+template <class Sliced, class Table>
+constexpr const Sliced* sliceOf(const Table* table) {
+	if constexpr (std::is_same_v<Table, Sliced>) {
+		return table;
+	} else {
+		return std::get<const Sliced*>(table->slices);
+	}
+}
 
 } // namespace detail
 
 // Class implementing a vtable whose storage is held remotely. This is
-// basically a pointer to a static instance of the specified `VTable`.
-template <class VTable>
+// basically a pointer to a static instance of the specified `VTable`, shared
+// by the polys of `Concept` (see `detail::SharedTable`).
+template <class VTable, class Concept = caramel::poly::Concept<>>
 struct RemoteVTable {
 
+	using Table = detail::SharedTable<VTable, Concept>;
+
 	constexpr RemoteVTable() = default;
 
 	template <class ConceptMap>
 	constexpr explicit RemoteVTable(ConceptMap) :
-		vptr_{&detail::STATIC_VTABLE<VTable, ConceptMap>}
+		vptr_{detail::staticVTable<Table, ConceptMap>()}
+	{
+	}
+
+	// Refers to `vtable`, which must outlive this vtable.
+	constexpr explicit RemoteVTable(const Table* vtable) :
+		vptr_{vtable}
+	{
+	}
+
+	template <class OtherVTable, std::enable_if_t<OtherVTable::template hasSlice<Table>()>* = nullptr>
+	constexpr RemoteVTable(detail::SliceTag, const OtherVTable& other) :
+		vptr_{other.template slice<Table>()}
 	{
 	}
 
@@ -153,14 +520,407 @@ struct RemoteVTable {
 		return VTable{}.contains(Name{});
 	}
 
-	friend void swap(RemoteVTable& a, RemoteVTable& b) {
+	template <class Name>
+	constexpr const void* sharedTable(Name) const {
+		return vptr_;
+	}
+
+	template <class Sliced>
+	static constexpr bool hasSlice() {
+		return detail::slicesTo<Table, Sliced>;
+	}
+
+	template <class Sliced>
+	constexpr const Sliced* slice() const {
+		return detail::sliceOf<Sliced>(vptr_);
+	}
+
+	friend void swap(RemoteVTable& a, RemoteVTable& b) noexcept {
 		using std::swap;
 		swap(a.vptr_, b.vptr_);
 	}
 
 private:
 
-	const VTable* vptr_;
+	const Table* vptr_ = nullptr;
+
+};
+
+// Class implementing a vtable stored remotely, like `RemoteVTable`, but
+// referred to by a dense index instead of a pointer. The index takes as
+// little as 2 bytes, which leaves more room for the object in a `Poly` of a
+// given size; for example, a 4-byte index and a 12-byte `LocalStorage` fit
+// in 16 bytes. Looking a function up costs one more load than with a
+// `RemoteVTable`, that of the array of vtables, which is usually cached.
+//
+// The indices are assigned per `VTable` and `Concept`, as objects of new
+// types are stored with it, so the number of types must fit in `Index`;
+// storing an object of one type too many throws `std::length_error`. Since
+// the indices are dense, they can also be used to test the type of the
+// object, or to index tables for multiple dispatch. Note that they are
+// assigned at run time, in an unspecified order, so they mustn't be
+// persisted.
+template <class VTable, class Index = std::uint32_t, class Concept = caramel::poly::Concept<>>
+struct IndexedVTable {
+
+	static_assert(std::is_unsigned_v<Index>,
+		"caramel::poly::IndexedVTable: The index type must be an unsigned integer type.");
+
+	using Table = detail::SharedTable<VTable, Concept>;
+
+	constexpr IndexedVTable() = default;
+
+	template <class ConceptMap>
+	explicit IndexedVTable(ConceptMap map) :
+		index_{indexOf(map)}
+	{
+	}
+
+	template <class OtherVTable, std::enable_if_t<OtherVTable::template hasSlice<Table>()>* = nullptr>
+	IndexedVTable(detail::SliceTag, const OtherVTable& other) :
+		index_{narrow(other.template slice<Table>()->indexOf())}
+	{
+	}
+
+	template <class Name>
+	auto operator[](Name name) const {
+		return detail::VTableRegistry<Table>::at(index_)[name];
+	}
+
+	template <class Name>
+	constexpr auto contains(Name) const {
+		return VTable{}.contains(Name{});
+	}
+
+	template <class Name>
+	const void* sharedTable(Name) const {
+		return &detail::VTableRegistry<Table>::at(index_);
+	}
+
+	template <class Sliced>
+	static constexpr bool hasSlice() {
+		return detail::slicesTo<Table, Sliced>;
+	}
+
+	template <class Sliced>
+	const Sliced* slice() const {
+		return detail::sliceOf<Sliced>(&detail::VTableRegistry<Table>::at(index_));
+	}
+
+	// The index of the vtable.
+	Index index() const noexcept {
+		return index_;
+	}
+
+	// The index of the vtable built from `ConceptMap`.
+	template <class ConceptMap>
+	static Index indexOf(ConceptMap) {
+		return narrow(detail::VTableRegistry<Table>::template indexOf<ConceptMap>());
+	}
+
+	friend void swap(IndexedVTable& a, IndexedVTable& b) noexcept {
+		using std::swap;
+		swap(a.index_, b.index_);
+	}
+
+private:
+
+	static Index narrow(std::size_t index) {
+		if (index > std::numeric_limits<Index>::max()) {
+			throw std::length_error("caramel::poly::IndexedVTable: Too many types for the index type");
+		}
+		return static_cast<Index>(index);
+	}
+
+	Index index_ = 0;
+
+};
+
+namespace detail {
+
+template <class VTable, class = void>
+constexpr bool isIndexedVTable = false;
+
+template <class VTable>
+constexpr bool isIndexedVTable<VTable, std::void_t<decltype(std::declval<const VTable&>().index())>> = true;
+
+} // namespace detail
+
+namespace detail {
+
+// Calls `f` with `std::integral_constant<std::size_t, tag>`, for a `tag`
+// known only at run time to be less than `COUNT`, through a `switch` over
+// blocks of 8 tags, so the compiler can lay the calls out as a jump table
+// and inline each of them.
+template <std::size_t COUNT, std::size_t TAG, class F>
+constexpr decltype(auto) visitCase(F& f) {
+	return f(std::integral_constant<std::size_t, (TAG < COUNT ? TAG : COUNT - 1)>{});
+}
+
+template <std::size_t COUNT, std::size_t FIRST = 0, class F>
+constexpr decltype(auto) visitTag(std::size_t tag, F& f) {
+	switch (tag - FIRST) {
+	case 0: return visitCase<COUNT, FIRST + 0>(f);
+	case 1: return visitCase<COUNT, FIRST + 1>(f);
+	case 2: return visitCase<COUNT, FIRST + 2>(f);
+	case 3: return visitCase<COUNT, FIRST + 3>(f);
+	case 4: return visitCase<COUNT, FIRST + 4>(f);
+	case 5: return visitCase<COUNT, FIRST + 5>(f);
+	case 6: return visitCase<COUNT, FIRST + 6>(f);
+	case 7: return visitCase<COUNT, FIRST + 7>(f);
+	default:
+		if constexpr (FIRST + 8 < COUNT) {
+			return visitTag<COUNT, FIRST + 8>(tag, f);
+		} else {
+			assert(false && "caramel::poly::detail::visitTag: Tag out of range");
+			return visitCase<COUNT, COUNT - 1>(f);
+		}
+	}
+}
+
+// The tag of the first of `Ts` whose concept map for `Concept` is
+// `ConceptMap`, or `sizeof...(Ts)` if there is none.
+template <class Concept, class ConceptMap, class... Ts>
+constexpr std::size_t sealedTag() {
+	constexpr bool matches[] = { std::is_same_v<ConceptMap, DefaultConceptMap<Concept, Ts>>..., false };
+	auto tag = std::size_t(0);
+	while (tag != sizeof...(Ts) && !matches[tag]) {
+		++tag;
+	}
+	return tag;
+}
+
+// Whether calling a function read from a vtable can't throw, be it a pointer
+// to a function or a function object holding one (as `SealedFunction`).
+template <class Function, class = void>
+constexpr auto isNoexceptFunction = isNoexceptSignature<Function>;
+
+template <class Function>
+constexpr auto isNoexceptFunction<Function, std::void_t<typename Function::FunctionPtr>> =
+	isNoexceptSignature<typename Function::FunctionPtr>;
+
+// A key identifying a function read from a vtable, for code that groups or
+// hashes vtable entries: the address of a pointer to a function, and what
+// the `key` member function of a function object (as `SealedFunction`)
+// returns. Entries calling the same function have the same key.
+template <class Function>
+std::uintptr_t functionKey(const Function& function) noexcept {
+	if constexpr (std::is_pointer_v<Function>) {
+		return reinterpret_cast<std::uintptr_t>(function);
+	} else {
+		return function.key();
+	}
+}
+
+// The function named `Name` of a `SealedVTable`, which calls the function of
+// the concept map of the type with the given tag. See `SealedVTable`.
+template <class Concept, class Name, class Signature, class ErasedSignature, class... Ts>
+class SealedFunction;
+
+template <class Concept, class Name, class Signature, class R, class... Params, class... Ts>
+class SealedFunction<Concept, Name, Signature, R (Params...), Ts...> {
+public:
+
+	using FunctionPtr = typename EraseSignature<Signature>::Type*;
+
+	constexpr explicit SealedFunction(std::size_t tag) :
+		tag_{tag}
+	{
+	}
+
+	R operator()(Params... params) const noexcept(isNoexceptSignature<FunctionPtr>) {
+		auto call = [&params...](auto tag) -> R {
+			constexpr auto function = SealedFunction::function<decltype(tag)::value>();
+			return function(std::forward<Params>(params)...);
+		};
+		return visitTag<sizeof...(Ts)>(tag_, call);
+	}
+
+	// The function as a pointer, for code that stores or compares vtable
+	// entries.
+	operator FunctionPtr() const noexcept {
+		return FUNCTIONS[tag_];
+	}
+
+	// See `functionKey`.
+	std::uintptr_t key() const noexcept {
+		return tag_;
+	}
+
+private:
+
+	template <std::size_t TAG>
+	static constexpr FunctionPtr function() {
+		using T = std::tuple_element_t<TAG, std::tuple<Ts...>>;
+		return EraseFunction<Signature>(DefaultConceptMap<Concept, T>{}[Name{}]);
+	}
+
+	template <std::size_t... TAGS>
+	static constexpr std::array<FunctionPtr, sizeof...(Ts)> functions(std::index_sequence<TAGS...>) {
+		return { function<TAGS>()... };
+	}
+
+	static constexpr std::array<FunctionPtr, sizeof...(Ts)> FUNCTIONS = functions(std::index_sequence_for<Ts...>{});
+
+	std::size_t tag_;
+
+};
+
+} // namespace detail
+
+// Class implementing a vtable for a closed set of types `Ts`, known when the
+// vtable type is defined. The vtable object is just the position of the type
+// of the object in `Ts`, which takes a single byte for up to 256 types, and
+// calling a function switches on that tag to a direct call to the function
+// of that type, which the compiler may inline. There is no table to load
+// the function from, and no indirect call the processor has to predict
+// (though a `switch` over many types may be compiled to an indirect jump).
+//
+// Only objects of `Ts`, with their default concept maps, may be stored in a
+// poly with such a vtable. `SealedStorage` is a storage that fits any of
+// them.
+template <class Concept, class Types, class... Mappings>
+struct SealedVTable;
+
+template <class Concept, class... Ts, class... Name, class... Clause>
+struct SealedVTable<Concept, std::tuple<Ts...>, detail::ConstexprPair<Name, Clause>...> {
+
+	static_assert(sizeof...(Ts) != 0 && sizeof...(Ts) <= std::numeric_limits<std::uint16_t>::max(),
+		"caramel::poly::SealedVTable: The number of sealed types must be between 1 and 65535.");
+
+	using Tag = std::conditional_t<(sizeof...(Ts) <= 256), std::uint8_t, std::uint16_t>;
+
+	constexpr SealedVTable() = default;
+
+	template <class ConceptMap>
+	constexpr explicit SealedVTable(ConceptMap map) :
+		tag_{indexOf(map)}
+	{
+	}
+
+	template <class OtherVTable>
+	SealedVTable(detail::SliceTag, const OtherVTable& other) :
+		tag_{sliceTag(other, std::index_sequence_for<Ts...>{})}
+	{
+	}
+
+	template <class OtherName>
+	constexpr auto contains(OtherName) const {
+		return (std::is_same_v<OtherName, Name> || ...);
+	}
+
+	template <class OtherName>
+	constexpr auto operator[](OtherName) const {
+		constexpr auto containsFunction = (std::is_same_v<OtherName, Name> || ...);
+		if constexpr (containsFunction && detail::holdsValue<ClauseOf<OtherName>>) {
+			return entry<OtherName>(tag_);
+		} else if constexpr (containsFunction) {
+			return Function<OtherName>{tag_};
+		} else {
+			static_assert(
+				containsFunction,
+				"caramel::poly::SealedVTable::operator[]: Request for a virtual function that is "
+				"not in the vtable. Was this function specified in the concept that "
+				"was used to instantiate this vtable?"
+				);
+		}
+	}
+
+	template <class OtherName>
+	constexpr const void* sharedTable(OtherName) const {
+		return nullptr;
+	}
+
+	// The shared table of any concept this one has the clauses of, built for
+	// the type with the tag of the vtable.
+	template <class Sliced>
+	static constexpr bool hasSlice() {
+		return detail::hasClausesOf(Concept{}, typename Sliced::Concept{});
+	}
+
+	template <class Sliced>
+	const Sliced* slice() const {
+		auto table = [](auto tag) -> const Sliced* {
+			using T = std::tuple_element_t<decltype(tag)::value, std::tuple<Ts...>>;
+			return detail::staticVTable<
+				Sliced,
+				detail::SliceMap<typename Sliced::Concept, detail::DefaultConceptMap<Concept, T>>
+				>();
+		};
+		return detail::visitTag<sizeof...(Ts)>(tag_, table);
+	}
+
+	// The tag of the vtable, i.e. the position of the type of the object in
+	// `Ts`.
+	constexpr Tag index() const noexcept {
+		return tag_;
+	}
+
+	// The tag of the vtable built from `ConceptMap`.
+	template <class ConceptMap>
+	static constexpr Tag indexOf(ConceptMap) {
+		constexpr auto tag = detail::sealedTag<Concept, ConceptMap, Ts...>();
+		static_assert(tag != sizeof...(Ts),
+			"caramel::poly::SealedVTable: The object is not of one of the sealed types, or is "
+			"stored with a concept map other than the default one of its type.");
+		return static_cast<Tag>(tag);
+	}
+
+	friend void swap(SealedVTable& a, SealedVTable& b) noexcept {
+		using std::swap;
+		swap(a.tag_, b.tag_);
+	}
+
+private:
+
+	template <class OtherName>
+	using ClauseOf = decltype(Concept{}.getSignature(OtherName{}));
+
+	template <class OtherName>
+	using Function = detail::SealedFunction<
+		Concept,
+		OtherName,
+		typename ClauseOf<OtherName>::Type,
+		typename detail::RemoveNoexcept<typename detail::EraseSignature<typename ClauseOf<OtherName>::Type>::Type>::Type,
+		Ts...
+		>;
+
+	template <class OtherName>
+	using Entry = typename detail::VTableEntry<ClauseOf<OtherName>>::Type;
+
+	// What a local vtable built for the type with the given tag holds for
+	// `OtherName`.
+	template <class OtherName>
+	static Entry<OtherName> entry(std::size_t tag) {
+		if constexpr (detail::holdsValue<ClauseOf<OtherName>>) {
+			auto read = [](auto type) -> Entry<OtherName> {
+				using T = std::tuple_element_t<decltype(type)::value, std::tuple<Ts...>>;
+				return detail::VTableEntry<ClauseOf<OtherName>>::make(
+					detail::DefaultConceptMap<Concept, T>{}[OtherName{}]);
+			};
+			return detail::visitTag<sizeof...(Ts)>(tag, read);
+		} else {
+			return Function<OtherName>{tag};
+		}
+	}
+
+	// The tag of the type whose functions `other` holds.
+	template <class OtherVTable, std::size_t... TAGS>
+	static Tag sliceTag(const OtherVTable& other, std::index_sequence<TAGS...>) {
+		auto tag = sizeof...(Ts);
+		((tag = tag == sizeof...(Ts) && holds<TAGS>(other) ? TAGS : tag), ...);
+		assert(tag != sizeof...(Ts) &&
+			"caramel::poly::SealedVTable: The object is not of one of the sealed types, or is "
+			"stored with a concept map other than the default one of its type.");
+		return static_cast<Tag>(tag);
+	}
+
+	template <std::size_t TAG, class OtherVTable>
+	static bool holds(const OtherVTable& other) {
+		return ((entry<Name>(TAG) == static_cast<Entry<Name>>(other[Name{}])) && ...);
+	}
+
+	Tag tag_ = 0;
 
 };
 
@@ -182,6 +942,19 @@ struct JoinedVTable {
 	{
 	}
 
+	template <
+		class OtherVTable,
+		std::enable_if_t<
+			std::is_constructible_v<First, detail::SliceTag, const OtherVTable&> &&
+			std::is_constructible_v<Second, detail::SliceTag, const OtherVTable&>
+			>* = nullptr
+		>
+	constexpr JoinedVTable(detail::SliceTag tag, const OtherVTable& other) :
+		first_{tag, other},
+		second_{tag, other}
+	{
+	}
+
 	template <class Name>
 	constexpr auto contains(Name name) const {
 		return first_.contains(name) || second_.contains(name);
@@ -216,8 +989,48 @@ struct JoinedVTable {
 		}
 	}
 
+	template <class Name>
+	constexpr const void* sharedTable(Name name) const {
+		if constexpr (First{}.contains(Name{})) {
+			return first_.sharedTable(name);
+		} else {
+			return second_.sharedTable(name);
+		}
+	}
+
+	template <class Sliced>
+	static constexpr bool hasSlice() {
+		return First::template hasSlice<Sliced>() || Second::template hasSlice<Sliced>();
+	}
+
+	template <class Sliced>
+	constexpr const Sliced* slice() const {
+		if constexpr (First::template hasSlice<Sliced>()) {
+			return first_.template slice<Sliced>();
+		} else {
+			return second_.template slice<Sliced>();
+		}
+	}
+
+	// The index of the indexed vtable joined (see `IndexedVTable`), if any.
+	template <class V = JoinedVTable, std::enable_if_t<detail::isIndexedVTable<typename V::IndexedPart>>* = nullptr>
+	auto index() const noexcept {
+		if constexpr (detail::isIndexedVTable<First>) {
+			return first_.index();
+		} else {
+			return second_.index();
+		}
+	}
+
+	template <class ConceptMap, class V = JoinedVTable, std::enable_if_t<detail::isIndexedVTable<typename V::IndexedPart>>* = nullptr>
+	static auto indexOf(ConceptMap map) {
+		return V::IndexedPart::indexOf(map);
+	}
+
 private:
 
+	using IndexedPart = std::conditional_t<detail::isIndexedVTable<First>, First, Second>;
+
 	First first_;
 
 	Second second_;
@@ -259,6 +1072,65 @@ struct Everything {
 
 using EverythingElse = Everything;
 
+// A profile listing no functions as hot.
+//
+// A profile is a class listing the names of the functions of a concept that
+// are called most often, as `static constexpr const char* HOT_FUNCTIONS[]`,
+// usually generated from call counts gathered at run time:
+//
+//   struct ShapeProfile {
+//       static constexpr const char* HOT_FUNCTIONS[] = { "draw", "bounds" };
+//   };
+//
+// Keeping the profile in a generated header lets the vtable layout follow
+// the profile without editing the concept.
+struct NoProfile {
+};
+
+namespace detail {
+
+template <class Profile, class = void>
+constexpr auto hasHotFunctions = false;
+
+template <class Profile>
+constexpr auto hasHotFunctions<Profile, std::void_t<decltype(Profile::HOT_FUNCTIONS)>> = true;
+
+constexpr bool equalStrings(const char* lhs, const char* rhs) {
+	while (*lhs != '\0' && *lhs == *rhs) {
+		++lhs;
+		++rhs;
+	}
+	return *lhs == *rhs;
+}
+
+template <class Profile, class Name>
+constexpr bool isProfiledHot(Name name) {
+	if constexpr (hasHotFunctions<Profile>) {
+		for (const char* function : Profile::HOT_FUNCTIONS) {
+			if (equalStrings(function, name.c_str())) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+} // namespace detail
+
+// Picks the functions of hot clauses (see `hot`), and the functions listed as
+// hot by `Profile`.
+template <class Profile = NoProfile>
+struct OnlyHot {
+	template <class All, class Concept>
+	constexpr auto operator()(All all, Concept) const {
+		auto matched = filter(all, [](auto name) {
+				return detail::isHotClause<decltype(Concept{}.getSignature(name))> ||
+					detail::isProfiledHot<Profile>(name);
+			});
+		return makeConstexprPair(difference(all, matched), matched);
+	}
+};
+
 namespace detail {
 
 template <class T>
@@ -273,6 +1145,20 @@ constexpr auto isValidSelector<caramel::poly::Except<Methods...>> = true;
 template <>
 constexpr auto isValidSelector<caramel::poly::Everything> = true;
 
+template <class Profile>
+constexpr auto isValidSelector<caramel::poly::OnlyHot<Profile>> = true;
+
+// Applies a selector to the functions of `Concept`. Selectors that need to
+// look at the clauses, like `OnlyHot`, are passed the concept as well.
+template <class Selector, class Concept, class All>
+constexpr auto select(Selector selector, Concept concept, All all) {
+	if constexpr (std::is_invocable_v<Selector, All, Concept>) {
+		return selector(all, concept);
+	} else {
+		return selector(all);
+	}
+}
+
 } // namespace detail
 
 //////////////////////////////////////////////////////////////////////////////
@@ -282,7 +1168,8 @@ struct Local {
 	static_assert(detail::isValidSelector<Selector>,
 		"caramel::poly::Local: Provided invalid selector. Valid selectors are "
 		"'caramel::poly::Only<METHODS...>', 'caramel::poly::Except<METHODS...>', "
-		"'caramel::poly::Everything', and 'caramel::poly::Everything_else'.");
+		"'caramel::poly::OnlyHot<PROFILE>', 'caramel::poly::Everything', and "
+		"'caramel::poly::Everything_else'.");
 
 	template <class Concept, class Functions>
 	static constexpr auto create(Concept, Functions functions) {
@@ -302,7 +1189,8 @@ struct Remote {
 	static_assert(detail::isValidSelector<Selector>,
 		"caramel::poly::Remote: Provided invalid selector. Valid selectors are "
 		"'caramel::poly::Only<METHODS...>', 'caramel::poly::Except<METHODS...>', "
-		"'caramel::poly::Everything', and 'caramel::poly::Everything_else'.");
+		"'caramel::poly::OnlyHot<PROFILE>', 'caramel::poly::Everything', and "
+		"'caramel::poly::Everything_else'.");
 
 	template <class Concept, class Functions>
 	static constexpr auto create(Concept, Functions functions) {
@@ -310,7 +1198,36 @@ struct Remote {
 			using VTable = caramel::poly::RemoteVTable<
 				caramel::poly::LocalVTable<
 					detail::ConstexprPair<decltype(f), decltype(Concept{}.getSignature(f))>...
-					>
+					>,
+				Concept
+				>;
+			return VTable{};
+		});
+	}
+
+	Selector selector;
+};
+
+// The policy of `IndexedVTable`. At most `std::numeric_limits<Index>::max() + 1`
+// types may be stored with the vtables it builds for a given set of functions;
+// `IndexedVTable` throws `std::length_error` past that.
+template <class Selector, class Index = std::uint32_t>
+struct Indexed {
+	static_assert(detail::isValidSelector<Selector>,
+		"caramel::poly::Indexed: Provided invalid selector. Valid selectors are "
+		"'caramel::poly::Only<METHODS...>', 'caramel::poly::Except<METHODS...>', "
+		"'caramel::poly::OnlyHot<PROFILE>', 'caramel::poly::Everything', and "
+		"'caramel::poly::Everything_else'.");
+
+	template <class Concept, class Functions>
+	static constexpr auto create(Concept, Functions functions) {
+		return unpack(functions, [](auto... f) {
+			using VTable = caramel::poly::IndexedVTable<
+				caramel::poly::LocalVTable<
+					detail::ConstexprPair<decltype(f), decltype(Concept{}.getSignature(f))>...
+					>,
+				Index,
+				Concept
 				>;
 			return VTable{};
 		});
@@ -319,6 +1236,27 @@ struct Remote {
 	Selector selector;
 };
 
+// The policy of `SealedVTable`, for the closed set of types `Ts`. It takes no
+// selector; the functions it is given are all those left by the policies
+// before it.
+template <class... Ts>
+struct Sealed {
+
+	template <class Concept, class Functions>
+	static constexpr auto create(Concept, Functions functions) {
+		return unpack(functions, [](auto... f) {
+			using VTable = caramel::poly::SealedVTable<
+				Concept,
+				std::tuple<Ts...>,
+				detail::ConstexprPair<decltype(f), decltype(Concept{}.getSignature(f))>...
+				>;
+			return VTable{};
+		});
+	}
+
+	Everything selector;
+};
+
 namespace detail {
 
 // Returns whether a vtable is empty, such that we can completely skip it
@@ -331,29 +1269,67 @@ constexpr auto isEmptyVTable<caramel::poly::LocalVTable<>> = true;
 
 } // namespace detail
 
+namespace detail {
+
+// The kind of vtable a policy lays its functions out in, e.g. `LocalVTable<>`
+// for all the `Local` policies.
+template <class Concept, class Policy>
+using VTableKind = decltype(Policy::create(Concept{}, ConstexprList<>{}));
+
+// Stands for a policy in a group of functions; policies themselves hold
+// their selector, so they can't be stored in a `ConstexprPair`.
+template <class PolicyT>
+struct PolicyTag {
+	using Policy = PolicyT;
+};
+
+// Adds `functions` to the group of policies of the same kind as `Policy` in
+// `groups`, a list of pairs of a `PolicyTag` and the functions of its kind.
+template <class Concept, class Policy, class Functions, class... Groups>
+constexpr auto addToGroup(ConstexprList<Groups...> groups, Functions functions) {
+	constexpr auto known =
+		(std::is_same_v<VTableKind<Concept, Policy>, VTableKind<Concept, typename Groups::First::Policy>> || ...);
+	if constexpr (known) {
+		return transform(groups, [functions](auto group) {
+				using GroupPolicy = typename decltype(group)::First::Policy;
+				if constexpr (std::is_same_v<VTableKind<Concept, Policy>, VTableKind<Concept, GroupPolicy>>) {
+					return makeConstexprPair(group.first(), concatenate(group.second(), functions));
+				} else {
+					return group;
+				}
+			});
+	} else {
+		return concatenate(groups, makeConstexprList(makeConstexprPair(PolicyTag<Policy>{}, functions)));
+	}
+}
+
+// Whether a group made by `addToGroup` holds the functions of local policies.
+template <class Concept, class Group>
+constexpr auto isLocalGroup = isEmptyVTable<VTableKind<Concept, typename Group::First::Policy>>;
+
+} // namespace detail
+
+// Generates the vtable for `Concept` laid out as specified by `Policies`.
+//
+// The functions picked by policies of the same kind are gathered into a
+// single vtable, whatever the number and order of the policies, and local
+// vtables come first. For example, `Local<Only<f>>, Remote<Only<g>>,
+// Local<Only<h>>, Remote<EverythingElse>` gives a vtable holding `f` and `h`
+// followed by a single pointer to a vtable holding all the other functions.
 template <class Concept, class Policies>
 constexpr auto generateVTable(Policies policies) {
 	auto functions = caramel::poly::detail::clauseNames(Concept{});
-	auto state = makeConstexprPair(functions, caramel::poly::LocalVTable<>{});
+	auto state = makeConstexprPair(functions, detail::makeConstexprList());
 
 	auto result = foldLeft(state, policies, [](auto state, auto policy) {
-			auto functions = state.first();
-			auto vtable = state.second();
-
-			auto selectorSplit = policy.selector(functions);
+			auto selectorSplit = detail::select(policy.selector, Concept{}, state.first());
 			auto remaining = selectorSplit.first();
 			auto matched = selectorSplit.second();
 
-			constexpr auto isEmpty = detail::isEmptyVTable<decltype(vtable)>;
-			if constexpr (isEmpty) {
-				auto newVTable = decltype(policy.create(Concept{}, matched)){};
-				return makeConstexprPair(remaining, newVTable);
+			if constexpr (empty(decltype(matched){})) {
+				return makeConstexprPair(remaining, state.second());
 			} else {
-				auto newVTable = caramel::poly::JoinedVTable<
-					decltype(vtable),
-					decltype(policy.create(Concept{}, matched))
-					>{};
-				return makeConstexprPair(remaining, newVTable);
+				return makeConstexprPair(remaining, detail::addToGroup<Concept, decltype(policy)>(state.second(), matched));
 			}
 		});
 
@@ -362,7 +1338,21 @@ constexpr auto generateVTable(Policies policies) {
 		"caramel::poly::VTable: The policies specified in the vtable did not fully cover all "
 		"the functions provided by the concept. Some functions were not mapped to "
 		"any vtable, which is an error");
-	return result.second();
+
+	auto groups = result.second();
+	auto ordered = concatenate(
+		filter(groups, [](auto group) { return detail::isLocalGroup<Concept, decltype(group)>; }),
+		filter(groups, [](auto group) { return !detail::isLocalGroup<Concept, decltype(group)>; })
+		);
+
+	return foldLeft(caramel::poly::LocalVTable<>{}, ordered, [](auto vtable, auto group) {
+			using GroupVTable = decltype(decltype(group)::First::Policy::create(Concept{}, group.second()));
+			if constexpr (detail::isEmptyVTable<decltype(vtable)>) {
+				return GroupVTable{};
+			} else {
+				return caramel::poly::JoinedVTable<decltype(vtable), GroupVTable>{};
+			}
+		});
 }
 
 // Policy-based interface for defining vtables.
@@ -382,6 +1372,12 @@ constexpr auto generateVTable(Policies policies) {
 //    to the vtable requires one indirection. In vanilla C++, this is the usual
 //    vtable implementation.
 //
+//  caramel::poly::Indexed<Selector, Index>
+//    Like `Remote`, except the vtable object is a dense index of type `Index`
+//    (an unsigned integer type, `std::uint32_t` by default) into a table of
+//    vtables, rather than a pointer. This makes the vtable object smaller at
+//    the cost of one more indirection. See `IndexedVTable`.
+//
 //  caramel::poly::Local<Selector>
 //    All functions selected by `Selector` will be stored in a local vtable.
 //    The vtable object will actually contain function pointers for all the
@@ -389,6 +1385,12 @@ constexpr auto generateVTable(Policies policies) {
 //    indirection is required (compared to a vtable stored remotely), at the
 //    cost of space inside the vtable object.
 //
+//  caramel::poly::Sealed<Ts...>
+//    All the remaining functions are dispatched by a `switch` over the
+//    position of the type of the object in `Ts`, the only types that may be
+//    stored. The vtable object is just that position, usually a single byte.
+//    See `SealedVTable`.
+//
 //
 // A selector is a type that selects a subset of functions defined by a concept.
 // Selectors are used to pick which policy applies to which functions when
@@ -417,6 +1419,11 @@ constexpr auto generateVTable(Policies policies) {
 //  caramel::poly::everything_else
 //    Equivalent to `caramel::poly::everything`, but prettier to read when other
 //    policies are used before it.
+//
+//  caramel::poly::OnlyHot<Profile>
+//    Picks the functions of the clauses marked with `caramel::poly::hot`, and
+//    the functions listed as hot by `Profile` (see `NoProfile`). For example,
+//    `caramel::poly::AutoVTable` keeps these locally and the rest remotely.
 template <class... Policies>
 struct VTable {
 
@@ -427,6 +1434,12 @@ struct VTable {
 
 };
 
+// A vtable keeping the functions of hot clauses, and of the functions listed
+// as hot by `Profile`, in the vtable object, and the others in a remote
+// vtable.
+template <class Profile = NoProfile>
+using AutoVTable = VTable<Local<OnlyHot<Profile>>, Remote<EverythingElse>>;
+
 } // namespace caramel::poly
 
 #endif /* CARAMELPOLY_VTABLE_HPP__ */
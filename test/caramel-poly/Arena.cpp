@@ -0,0 +1,75 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "caramel-poly/Arena.hpp"
+
+namespace /* anonymous */ {
+
+using namespace caramel::poly;
+
+bool isAligned(void* ptr, std::size_t alignment) {
+	return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(ArenaTest, AllocatesConsecutiveBlocks) {
+	auto arena = Arena();
+
+	auto* first = static_cast<char*>(arena.allocate(8, 8));
+	auto* second = static_cast<char*>(arena.allocate(8, 8));
+
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(second, first + 8);
+}
+
+TEST(ArenaTest, RespectsAlignment) {
+	auto arena = Arena();
+
+	arena.allocate(1, 1);
+	for (auto alignment : { 2u, 4u, 8u, 16u, 64u, 256u }) {
+		auto* ptr = arena.allocate(3, alignment);
+		ASSERT_NE(ptr, nullptr);
+		EXPECT_TRUE(isAligned(ptr, alignment));
+	}
+}
+
+TEST(ArenaTest, GrowsWhenBlockIsExhausted) {
+	auto arena = Arena(64);
+
+	for (auto i = 0; i != 16; ++i) {
+		ASSERT_NE(arena.allocate(32), nullptr);
+	}
+
+	EXPECT_GE(arena.capacity(), 16u * 32u);
+}
+
+TEST(ArenaTest, ServesRequestsLargerThanBlockSize) {
+	auto arena = Arena(64);
+
+	auto* ptr = static_cast<unsigned char*>(arena.allocate(1024));
+	ASSERT_NE(ptr, nullptr);
+	ptr[0] = 1;
+	ptr[1023] = 2;
+}
+
+TEST(ArenaTest, ResetReusesMemory) {
+	auto arena = Arena(64);
+
+	auto* first = arena.allocate(32);
+	arena.allocate(32);
+	arena.allocate(32);
+	const auto capacity = arena.capacity();
+
+	arena.reset();
+
+	EXPECT_EQ(arena.allocate(32), first);
+	arena.allocate(32);
+	arena.allocate(32);
+	EXPECT_EQ(arena.capacity(), capacity);
+}
+
+} // anonymous namespace
@@ -0,0 +1,105 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "caramel-poly/CallSiteCache.hpp"
+
+namespace /* anonymous */ {
+
+using namespace caramel::poly;
+
+constexpr auto NAME_NAME = POLY_FUNCTION_LABEL("name");
+constexpr auto APPEND_NAME = POLY_FUNCTION_LABEL("append");
+
+struct Named : decltype(requires(
+	CopyConstructible{},
+	NAME_NAME = method<std::string () const>,
+	APPEND_NAME = function<void (const SelfPlaceholder&, std::vector<std::string>&)>
+	))
+{
+};
+
+struct Cat {
+};
+
+struct Dog {
+};
+
+} // anonymous namespace
+
+template <>
+auto const caramel::poly::defaultConceptMap<Named, Cat> = makeConceptMap(
+	NAME_NAME = [](const Cat&) { return std::string("cat"); },
+	APPEND_NAME = [](const Cat&, std::vector<std::string>& names) { names.emplace_back("cat"); }
+	);
+
+template <>
+auto const caramel::poly::defaultConceptMap<Named, Dog> = makeConceptMap(
+	NAME_NAME = [](const Dog&) { return std::string("dog"); },
+	APPEND_NAME = [](const Dog&, std::vector<std::string>& names) { names.emplace_back("dog"); }
+	);
+
+namespace /* anonymous */ {
+
+TEST(CallSiteCacheTest, SkipsLookupsForRepeatedVTables) {
+	using NamedPoly = Poly<Named>;
+	const auto cat = NamedPoly(Cat{});
+	auto otherCat = NamedPoly(Cat{});
+	const auto dog = NamedPoly(Dog{});
+
+	auto cache = CallSiteCache<NamedPoly, decltype(NAME_NAME)>();
+	EXPECT_EQ(cache.invoke(cat), "cat");
+	EXPECT_EQ(cache.invoke(otherCat), "cat");
+	EXPECT_EQ(cache.invoke(dog), "dog");
+	EXPECT_EQ(cache.invoke(cat), "cat");
+	EXPECT_EQ(cache.hits(), 1u);
+	EXPECT_EQ(cache.misses(), 3u);
+
+	cache.reset();
+	EXPECT_EQ(cache.hits(), 0u);
+	EXPECT_EQ(cache.misses(), 0u);
+	EXPECT_EQ(cache.invoke(cat), "cat");
+	EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST(CallSiteCacheTest, CachesOnlyRemoteFunctions) {
+	using JoinedPoly = Poly<
+		Named,
+		RemoteStorage<>,
+		caramel::poly::VTable<Local<Only<decltype(NAME_NAME)>>, Remote<EverythingElse>>
+		>;
+	const auto cat = JoinedPoly(Cat{});
+	const auto dog = JoinedPoly(Dog{});
+
+	auto nameCache = CallSiteCache<JoinedPoly, decltype(NAME_NAME)>();
+	EXPECT_EQ(nameCache.invoke(cat), "cat");
+	EXPECT_EQ(nameCache.invoke(dog), "dog");
+	EXPECT_EQ(nameCache.hits(), 0u);
+	EXPECT_EQ(nameCache.misses(), 0u);
+
+	auto names = std::vector<std::string>();
+	auto appendCache = CallSiteCache<JoinedPoly, decltype(APPEND_NAME)>();
+	appendCache.invoke(cat, cat, names);
+	appendCache.invoke(cat, cat, names);
+	appendCache.invoke(dog, dog, names);
+	EXPECT_EQ(names, (std::vector<std::string>{ "cat", "cat", "dog" }));
+	EXPECT_EQ(appendCache.hits(), 1u);
+	EXPECT_EQ(appendCache.misses(), 2u);
+}
+
+TEST(CallSiteCacheTest, CachesPerCallSite) {
+	const auto polys = std::vector<Poly<Named>>{ Cat{}, Dog{}, Dog{} };
+
+	auto names = std::vector<std::string>();
+	for (const auto& poly : polys) {
+		names.emplace_back(POLY_CACHED_INVOKE(NAME_NAME, poly));
+		POLY_CACHED_INVOKE(APPEND_NAME, poly, poly, names);
+	}
+	EXPECT_EQ(names, (std::vector<std::string>{ "cat", "cat", "dog", "dog", "dog", "dog" }));
+}
+
+} // anonymous namespace
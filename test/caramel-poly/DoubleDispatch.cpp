@@ -0,0 +1,111 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "caramel-poly/DoubleDispatch.hpp"
+
+namespace /* anonymous */ {
+
+using namespace caramel::poly;
+using namespace std::string_literals;
+
+constexpr auto NAME_NAME = POLY_FUNCTION_LABEL("name");
+
+struct Shape : decltype(requires(
+	NAME_NAME = method<std::string () const>
+	))
+{
+};
+
+struct Circle {
+	int radius;
+};
+
+struct Square {
+	int side;
+};
+
+struct Triangle {
+};
+
+} // anonymous namespace
+
+template <class T>
+auto const caramel::poly::defaultConceptMap<Shape, T> = makeConceptMap(
+	NAME_NAME = [](const T&) { return "shape"s; }
+	);
+
+namespace /* anonymous */ {
+
+using IndexedShape = Poly<Shape, RemoteStorage<>, caramel::poly::VTable<Indexed<Everything>>>;
+
+TEST(DoubleDispatchTest, CallsFunctionsForPairsOfTypes) {
+	auto collide = DoubleDispatch<std::string (const SelfPlaceholder&, const SelfPlaceholder&, int), IndexedShape>();
+	collide.define<Circle, Circle>([](const Circle& a, const Circle& b, int depth) {
+			return "circles:"s + std::to_string(a.radius + b.radius + depth);
+		});
+	collide.define<Circle, Square>([](const Circle& a, const Square& b, int depth) {
+			return "circle-square:"s + std::to_string(a.radius + b.side + depth);
+		});
+	collide.define<Square, Circle>([](const Square& a, const Circle& b, int depth) {
+			return "square-circle:"s + std::to_string(a.side + b.radius + depth);
+		});
+
+	const auto circle = IndexedShape(Circle{ 1 });
+	const auto square = IndexedShape(Square{ 2 });
+	const auto triangle = IndexedShape(Triangle{});
+
+	EXPECT_EQ(collide(circle, circle, 10), "circles:12"s);
+	EXPECT_EQ(collide(circle, square, 10), "circle-square:13"s);
+	EXPECT_EQ(dispatch2(collide, square, circle, 20), "square-circle:23"s);
+
+	EXPECT_TRUE(collide.contains(square, circle));
+	EXPECT_FALSE(collide.contains(square, square));
+	EXPECT_FALSE(collide.contains(circle, triangle));
+	EXPECT_FALSE(collide.contains(triangle, circle));
+
+	EXPECT_THROW(collide(square, square, 10), std::out_of_range);
+	EXPECT_THROW(collide(circle, triangle, 10), std::out_of_range);
+}
+
+TEST(DoubleDispatchTest, DispatchesOnPolysOfDifferentTypes) {
+	using JoinedShape = Poly<
+		Shape,
+		RemoteStorage<>,
+		caramel::poly::VTable<Local<Only<decltype(NAME_NAME)>>, Indexed<EverythingElse, std::uint16_t>>
+		>;
+
+	auto absorb = DoubleDispatch<void (SelfPlaceholder&, const SelfPlaceholder&), IndexedShape, JoinedShape>();
+	absorb.define<Circle, Square>([](Circle& a, const Square& b) { a.radius += b.side; });
+
+	auto circle = IndexedShape(Circle{ 1 });
+	const auto square = JoinedShape(Square{ 2 });
+	absorb(circle, square);
+	absorb(circle, square);
+	EXPECT_EQ(circle.unsafeGet<Circle>()->radius, 5);
+	EXPECT_FALSE(absorb.contains(circle, JoinedShape(Circle{ 1 })));
+}
+
+TEST(DoubleDispatchTest, KeepsObjectsSharedForConstParameters) {
+	struct CopyableShape : decltype(requires(Shape{}, CopyConstructible{})) {
+	};
+	using CowShape = Poly<CopyableShape, CowStorage<NonAtomicRefCount>, caramel::poly::VTable<Indexed<Everything>>>;
+
+	auto radii = DoubleDispatch<int (const SelfPlaceholder&, const SelfPlaceholder&), CowShape>();
+	radii.define<Circle, Circle>([](const Circle& a, const Circle& b) { return a.radius + b.radius; });
+
+	const auto original = CowShape(Circle{ 1 });
+	auto a = original;
+	auto b = original;
+	EXPECT_EQ(radii(a, b), 2);
+	EXPECT_EQ(std::as_const(a).unsafeGet<Circle>(), original.unsafeGet<Circle>());
+	EXPECT_EQ(std::as_const(b).unsafeGet<Circle>(), original.unsafeGet<Circle>());
+}
+
+} // anonymous namespace
@@ -3,7 +3,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <memory_resource>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include "caramel-poly/Poly.hpp"
 
@@ -64,8 +68,202 @@ std::string print(const WithFloat& t) {
 	return "fprint:T:" + std::to_string(t.f);
 }
 
+constexpr auto INCREMENT_NAME = POLY_FUNCTION_LABEL("increment");
+constexpr auto VALUE_NAME = POLY_FUNCTION_LABEL("value");
+
+struct Counter : decltype(requires(
+	CopyConstructible{},
+	INCREMENT_NAME = method<void ()>,
+	VALUE_NAME = method<int () const>
+	))
+{
+};
+
+constexpr auto RESET_NAME = POLY_FUNCTION_LABEL("reset");
+
+struct ResettableCounter : decltype(requires(
+	Counter{},
+	MoveConstructible{},
+	RESET_NAME = method<void ()>
+	))
+{
+};
+
+struct HotCounter : decltype(requires(
+	INCREMENT_NAME = hot(method<void ()>),
+	VALUE_NAME = method<int () const>
+	))
+{
+};
+
+constexpr auto ADD_NAME = POLY_FUNCTION_LABEL("add");
+constexpr auto READ_NAME = POLY_FUNCTION_LABEL("read");
+
+struct BatchCounter : decltype(requires(
+	ADD_NAME = batchMethod<void (int)>,
+	READ_NAME = batchMethod<void (int*) const>
+	))
+{
+};
+
+struct IntCounter {
+	int i;
+};
+
+struct LongCounter {
+	long long i;
+};
+
+template <std::size_t POINTERS>
+struct PaddedCounter {
+	long long i;
+	void* padding[POINTERS];
+};
+
+constexpr auto AREA_NAME = POLY_FUNCTION_LABEL("area");
+constexpr auto SCALE_NAME = POLY_FUNCTION_LABEL("scale");
+constexpr auto SERIALIZE_NAME = POLY_FUNCTION_LABEL("serialize");
+
+struct Shape : decltype(requires(
+	Castable{},
+	AREA_NAME = method<int () const>,
+	SCALE_NAME = method<void (int)>
+	))
+{
+};
+
+struct Serializable : decltype(requires(
+	Castable{},
+	SERIALIZE_NAME = method<std::string () const>
+	))
+{
+};
+
+struct Square {
+	int side;
+};
+
+struct Circle {
+	int radius;
+};
+
+constexpr auto SIZE_NAME = POLY_FUNCTION_LABEL("size");
+constexpr auto APPEND_NAME = POLY_FUNCTION_LABEL("append");
+constexpr auto EMPTY_NAME = POLY_FUNCTION_LABEL("empty");
+
+struct Sized : decltype(requires(
+	SIZE_NAME = method<std::size_t () const noexcept>,
+	APPEND_NAME = method<void (std::string) noexcept>,
+	EMPTY_NAME = function<bool (const caramel::poly::SelfPlaceholder&) noexcept>
+	))
+{
+};
+
+constexpr auto KEY_NAME = POLY_FUNCTION_LABEL("key");
+
+struct Keyed : decltype(requires(
+	KEY_NAME = field<int>
+	))
+{
+};
+
+struct Tagged {
+	std::string name;
+	int key;
+};
+
+struct Weighted {
+	double weight;
+};
+
+struct Item {
+	int key;
+};
+
+struct WeightedItem : Weighted, Item {
+};
+
+struct Derived : WeightedItem {
+	virtual ~Derived() = default;
+};
+
+struct VirtualItem : virtual Weighted {
+	int key;
+};
+
 } // anonymous namespace
 
+template <>
+auto const caramel::poly::defaultConceptMap<Shape, Square> = makeConceptMap(
+	AREA_NAME = [](const Square& s) { return s.side * s.side; },
+	SCALE_NAME = [](Square& s, int factor) { s.side *= factor; }
+	);
+
+template <>
+auto const caramel::poly::defaultConceptMap<Serializable, Square> = makeConceptMap(
+	SERIALIZE_NAME = [](const Square& s) { return "square:"s + std::to_string(s.side); }
+	);
+
+template <>
+auto const caramel::poly::defaultConceptMap<Shape, Circle> = makeConceptMap(
+	AREA_NAME = [](const Circle& c) { return 3 * c.radius * c.radius; },
+	SCALE_NAME = [](Circle& c, int factor) { c.radius *= factor; }
+	);
+
+template <>
+auto const caramel::poly::defaultConceptMap<Sized, std::string> = makeConceptMap(
+	SIZE_NAME = [](const std::string& s) { return s.size(); },
+	APPEND_NAME = [](std::string& s, std::string suffix) { s += suffix; },
+	EMPTY_NAME = [](const std::string& s) noexcept { return s.empty(); }
+	);
+
+template <>
+auto const caramel::poly::defaultConceptMap<Keyed, Tagged> = makeConceptMap(
+	KEY_NAME = member<&Tagged::key>
+	);
+
+template <>
+auto const caramel::poly::defaultConceptMap<Keyed, WeightedItem> = makeConceptMap(
+	KEY_NAME = member<&WeightedItem::key>
+	);
+
+template <>
+auto const caramel::poly::defaultConceptMap<Keyed, Derived> = makeConceptMap(
+	KEY_NAME = member<&Derived::key>
+	);
+
+template <>
+auto const caramel::poly::defaultConceptMap<Keyed, VirtualItem> = makeConceptMap(
+	KEY_NAME = member<&VirtualItem::key>
+	);
+
+template <class T>
+constexpr auto caramel::poly::defaultConceptMap<Counter, T> = makeConceptMap(
+	INCREMENT_NAME = [](auto& c) { ++c.i; },
+	VALUE_NAME = [](const auto& c) { return c.i; }
+	);
+
+template <class T>
+constexpr auto caramel::poly::defaultConceptMap<ResettableCounter, T> = makeConceptMap(
+	RESET_NAME = [](auto& c) { c.i = 0; }
+	);
+
+template <class T>
+constexpr auto caramel::poly::defaultConceptMap<HotCounter, T> = makeConceptMap(
+	INCREMENT_NAME = [](auto& c) { ++c.i; },
+	VALUE_NAME = [](const auto& c) { return c.i; }
+	);
+
+template <class T>
+constexpr auto caramel::poly::defaultConceptMap<BatchCounter, T> = makeConceptMap(
+	ADD_NAME = [](T* counters, std::size_t count, int amount) {
+			for (auto i = std::size_t(0); i != count; ++i) {
+				counters[i].i += amount;
+			}
+		},
+	READ_NAME = [](const T& counter, int* out) { *out = counter.i; }
+	);
+
 template <class T>
 constexpr auto caramel::poly::defaultConceptMap<Printable, T> = makeConceptMap(
 	CONST_PRINT_NAME = [](const auto& o) { return o.print(); },
@@ -108,6 +306,128 @@ TEST(PolyTest, InvokesBasicPolymorphicCalls) {
 	EXPECT_EQ(sp.invoke(FREE_PRINT_NAME, sp), "fprint:int:12"s);
 }
 
+TEST(PolyTest, InvokesLikelyTypesDirectly) {
+	auto sp = Poly<Printable>(WithInt{ 42 });
+	EXPECT_EQ(std::as_const(sp).invokeLikely<WithInt>(CONST_PRINT_NAME), "cprint:S:42"s);
+	EXPECT_EQ((sp.invokeLikely<WithFloat, WithInt>(NONCONST_PRINT_NAME)), "ncprint:S:42"s);
+	EXPECT_EQ((sp.invokeLikely<WithInt, WithFloat>(FREE_PRINT_NAME, sp)), "fprint:S:42"s);
+	EXPECT_EQ(sp.invokeLikely<WithFloat>(CONST_PRINT_NAME), "cprint:S:42"s);
+	EXPECT_EQ(sp.invokeLikely<>(CONST_PRINT_NAME), "cprint:S:42"s);
+
+	sp = Poly<Printable>(12);
+	EXPECT_EQ((sp.invokeLikely<WithInt, int>(CONST_PRINT_NAME)), "cprint:int:12"s);
+
+	using LocalPrintable = Poly<Printable, RemoteStorage<>, caramel::poly::VTable<Local<Everything>>>;
+	auto local = LocalPrintable(WithFloat{ 3.14f });
+	EXPECT_EQ(local.invokeLikely<WithFloat>(CONST_PRINT_NAME), "cprint:T:"s + std::to_string(3.14f));
+	EXPECT_EQ(local.invokeLikely<WithInt>(NONCONST_PRINT_NAME), "ncprint:T:"s + std::to_string(3.14f));
+
+	auto custom = Poly<Printable>(WithInt{ 1 }, makeConceptMap(
+		CONST_PRINT_NAME = [](const WithInt&) { return "custom"s; }
+		));
+	EXPECT_EQ(custom.invokeLikely<WithInt>(CONST_PRINT_NAME), "custom"s);
+	EXPECT_EQ(custom.invokeLikely<WithInt>(NONCONST_PRINT_NAME), "ncprint:S:1"s);
+}
+
+TEST(PolyTest, PacksIndexedVTableWithLocalStorage) {
+	using IndexedPrintable = Poly<Printable, LocalStorage<12, 4>, caramel::poly::VTable<Indexed<Everything>>>;
+	static_assert(sizeof(IndexedPrintable) == 16);
+
+	auto sp = IndexedPrintable(WithInt{ 42 });
+	EXPECT_EQ(sp.invoke(CONST_PRINT_NAME), "cprint:S:42"s);
+	EXPECT_EQ(sp.invoke(FREE_PRINT_NAME, sp), "fprint:S:42"s);
+
+	auto other = IndexedPrintable(WithFloat{ 3.14f });
+	EXPECT_EQ(other.invoke(NONCONST_PRINT_NAME), "ncprint:T:"s + std::to_string(3.14f));
+	EXPECT_EQ(sp.invoke(NONCONST_PRINT_NAME), "ncprint:S:42"s);
+}
+
+TEST(PolyTest, FillsCompactStorageWithInlineObjects) {
+	using CompactCounter = Poly<ResettableCounter, CompactSBOStorage<2 * sizeof(void*)>>;
+	static_assert(sizeof(CompactCounter) == 3 * sizeof(void*));
+
+	const auto isInline = [](const CompactCounter& counter) {
+		const auto* object = counter.unsafeGet<char>();
+		const auto* begin = reinterpret_cast<const char*>(&counter);
+		return object >= begin && object < begin + sizeof(counter);
+	};
+
+	auto small = CompactCounter(PaddedCounter<1>{ 1, {} });
+	auto big = CompactCounter(PaddedCounter<2>{ 10, {} });
+	EXPECT_TRUE(isInline(small));
+	EXPECT_FALSE(isInline(big));
+
+	small.invoke(INCREMENT_NAME);
+	EXPECT_EQ(small.invoke(VALUE_NAME), 2);
+
+	auto copy = small;
+	EXPECT_TRUE(isInline(copy));
+	EXPECT_EQ(copy.invoke(VALUE_NAME), 2);
+
+	swap(small, big);
+	EXPECT_FALSE(isInline(small));
+	EXPECT_TRUE(isInline(big));
+	EXPECT_EQ(small.invoke(VALUE_NAME), 10);
+	EXPECT_EQ(big.invoke(VALUE_NAME), 2);
+
+	auto moved = std::move(big);
+	EXPECT_TRUE(isInline(moved));
+	EXPECT_EQ(moved.invoke(VALUE_NAME), 2);
+}
+
+TEST(PolyTest, DispatchesOnSealedTypeTags) {
+	using SealedPrintable = Poly<
+		Printable,
+		SealedStorage<WithInt, WithFloat, int>,
+		caramel::poly::VTable<Sealed<WithInt, WithFloat, int>>
+		>;
+	static_assert(sizeof(SealedPrintable) == 8);
+
+	auto sp = SealedPrintable(WithInt{ 42 });
+	EXPECT_EQ(detail::PolyAccess::vtable(sp).index(), 0);
+	EXPECT_EQ(sp.invoke(CONST_PRINT_NAME), "cprint:S:42"s);
+	EXPECT_EQ(sp.invoke(FREE_PRINT_NAME, sp), "fprint:S:42"s);
+	EXPECT_EQ((sp.invokeLikely<WithFloat, WithInt>(NONCONST_PRINT_NAME)), "ncprint:S:42"s);
+
+	auto other = SealedPrintable(12);
+	EXPECT_EQ(detail::PolyAccess::vtable(other).index(), 2);
+	EXPECT_EQ(other.invoke(NONCONST_PRINT_NAME), "ncprint:int:12"s);
+	EXPECT_EQ(sp.invoke(NONCONST_PRINT_NAME), "ncprint:S:42"s);
+	EXPECT_EQ(other.virtual_(STORAGE_INFO_LABEL)().size, sizeof(int));
+	EXPECT_EQ(sp.virtual_(STORAGE_INFO_LABEL)().size, sizeof(WithInt));
+}
+
+TEST(PolyTest, CopiesAndUpcastsSealedPolys) {
+	using SealedCounter = Poly<
+		ResettableCounter,
+		SealedStorage<IntCounter, LongCounter>,
+		caramel::poly::VTable<Sealed<IntCounter, LongCounter>>
+		>;
+	using SealedBase = Poly<
+		Counter,
+		SealedStorage<IntCounter, LongCounter>,
+		caramel::poly::VTable<Local<Only<decltype(VALUE_NAME)>>, Sealed<IntCounter, LongCounter>>
+		>;
+
+	const auto counter = SealedCounter(LongCounter{ 1 });
+	auto copy = counter;
+	copy.invoke(INCREMENT_NAME);
+	EXPECT_EQ(copy.invoke(VALUE_NAME), 2);
+	EXPECT_EQ(counter.invoke(VALUE_NAME), 1);
+
+	auto moved = SealedCounter(std::move(copy));
+	moved.invoke(RESET_NAME);
+	EXPECT_EQ(moved.invoke(VALUE_NAME), 0);
+
+	const auto remote = Poly<Counter, SealedStorage<IntCounter, LongCounter>>(counter);
+	EXPECT_EQ(remote.invoke(VALUE_NAME), 1);
+
+	auto base = SealedBase(moved);
+	base.invoke(INCREMENT_NAME);
+	EXPECT_EQ(base.invoke(VALUE_NAME), 1);
+	EXPECT_EQ(detail::PolyAccess::vtable(base).index(), 1);
+}
+
 TEST(PolyTest, StorableAndDestructibleByDefault) {
 	auto sp = Poly<Printable>(WithInt{ 42 });
 
@@ -119,4 +439,190 @@ TEST(PolyTest, StorableAndDestructibleByDefault) {
 	sp.virtual_(DESTRUCT_LABEL);
 }
 
+TEST(PolyTest, CopiesOnWrite) {
+	using CowCounter = Poly<Counter, CowStorage<NonAtomicRefCount>>;
+
+	const auto original = CowCounter(IntCounter{ 1 });
+	auto copy = original;
+	EXPECT_EQ(std::as_const(copy).unsafeGet<IntCounter>(), original.unsafeGet<IntCounter>());
+	EXPECT_EQ(copy.invoke(VALUE_NAME), 1);
+	EXPECT_EQ(std::as_const(copy).unsafeGet<IntCounter>(), original.unsafeGet<IntCounter>());
+
+	copy.invoke(INCREMENT_NAME);
+	EXPECT_NE(std::as_const(copy).unsafeGet<IntCounter>(), original.unsafeGet<IntCounter>());
+	EXPECT_EQ(copy.invoke(VALUE_NAME), 2);
+	EXPECT_EQ(original.invoke(VALUE_NAME), 1);
+
+	auto another = original;
+	another.unsafeGet<IntCounter>()->i = 42;
+	EXPECT_EQ(another.invoke(VALUE_NAME), 42);
+	EXPECT_EQ(original.invoke(VALUE_NAME), 1);
+}
+
+int incremented(Poly<Counter> counter) {
+	counter.invoke(INCREMENT_NAME);
+	return counter.invoke(VALUE_NAME);
+}
+
+TEST(PolyTest, UpcastsToRefinedConcepts) {
+	static_assert(std::is_convertible_v<Poly<ResettableCounter>, Poly<Counter>>);
+	static_assert(!detail::isUpcastable<Poly<ResettableCounter>, Poly<Counter>>);
+
+	auto resettable = Poly<ResettableCounter>(IntCounter{ 1 });
+	EXPECT_EQ(incremented(resettable), 2);
+	EXPECT_EQ(resettable.invoke(VALUE_NAME), 1);
+
+	const auto* object = resettable.unsafeGet<IntCounter>();
+	auto counter = Poly<Counter>(std::move(resettable));
+	EXPECT_EQ(counter.unsafeGet<IntCounter>(), object);
+	counter.invoke(INCREMENT_NAME);
+	EXPECT_EQ(counter.invoke(VALUE_NAME), 2);
+
+	const auto& remote = detail::PolyAccess::vtable(counter);
+	EXPECT_EQ(remote[INCREMENT_NAME], (detail::PolyAccess::vtable(Poly<Counter>(IntCounter{ 0 }))[INCREMENT_NAME]));
+}
+
+TEST(PolyTest, UpcastsBetweenVTablePolicies) {
+	using LocalCounter = Poly<Counter, SBOStorage<16>, caramel::poly::VTable<Local<Everything>>>;
+	using IndexedCounter = Poly<Counter, SBOStorage<16>, caramel::poly::VTable<Indexed<Everything>>>;
+	using JoinedResettable = Poly<
+		ResettableCounter,
+		SBOStorage<16>,
+		caramel::poly::VTable<Local<Only<decltype(RESET_NAME)>>, Remote<EverythingElse>>
+		>;
+
+	auto resettable = JoinedResettable(IntCounter{ 3 });
+	const auto local = LocalCounter(resettable);
+	EXPECT_EQ(local.invoke(VALUE_NAME), 3);
+	EXPECT_EQ(detail::PolyAccess::vtable(local)[VALUE_NAME], detail::PolyAccess::vtable(resettable)[VALUE_NAME]);
+
+	auto indexed = IndexedCounter(std::move(resettable));
+	indexed.invoke(INCREMENT_NAME);
+	EXPECT_EQ(indexed.invoke(VALUE_NAME), 4);
+	EXPECT_EQ(
+		detail::PolyAccess::vtable(indexed).index(),
+		detail::PolyAccess::vtable(IndexedCounter(IntCounter{ 0 })).index()
+		);
+
+	// Local vtables have no shared table to slice.
+	static_assert(!std::is_constructible_v<IndexedCounter, const LocalCounter&>);
+	static_assert(std::is_constructible_v<LocalCounter, const IndexedCounter&>);
+}
+
+TEST(PolyTest, ViewsObjectsAsOtherConcepts) {
+	EXPECT_EQ(Poly<Serializable>(Square{ 1 }).invoke(SERIALIZE_NAME), "square:1"s);
+
+	auto square = Poly<Shape>(Square{ 2 });
+	auto serializable = square.tryAs<Serializable>();
+	ASSERT_TRUE(serializable.has_value());
+	EXPECT_EQ(serializable->invoke(SERIALIZE_NAME), "square:2"s);
+
+	square.invoke(SCALE_NAME, 3);
+	EXPECT_EQ(serializable->invoke(SERIALIZE_NAME), "square:6"s);
+	EXPECT_EQ(serializable->unsafeGet<Square>(), std::as_const(square).unsafeGet<Square>());
+
+	const auto& constSquare = square;
+	const auto shape = constSquare.tryAs<Shape>();
+	ASSERT_TRUE(shape.has_value());
+	EXPECT_EQ(shape->invoke(AREA_NAME), 36);
+
+	auto circle = Poly<Shape>(Circle{ 1 });
+	EXPECT_FALSE(circle.tryAs<Serializable>().has_value());
+	EXPECT_EQ(circle.tryAs<Shape>()->invoke(AREA_NAME), 3);
+}
+
+TEST(PolyTest, KeepsHotFunctionsLocal) {
+	auto counter = Poly<HotCounter, RemoteStorage<>, AutoVTable<>>(IntCounter{ 1 });
+	counter.invoke(INCREMENT_NAME);
+	EXPECT_EQ(counter.invoke(VALUE_NAME), 2);
+}
+
+TEST(PolyTest, CallsBatchMethodsOnASingleObject) {
+	auto counter = Poly<BatchCounter>(IntCounter{ 1 });
+	counter.invoke(ADD_NAME, 2);
+
+	auto value = 0;
+	std::as_const(counter).invoke(READ_NAME, &value);
+	EXPECT_EQ(value, 3);
+}
+
+TEST(PolyTest, CallsNoexceptFunctions) {
+	auto sized = Poly<Sized>("ab"s);
+	static_assert(noexcept(sized.invoke(SIZE_NAME)));
+	static_assert(noexcept(sized.invoke(EMPTY_NAME, sized)));
+	static_assert(noexcept(sized.invoke(APPEND_NAME, std::declval<std::string>())));
+	static_assert(!noexcept(sized.invoke(APPEND_NAME, "c")));
+
+	sized.invoke(APPEND_NAME, "c");
+	EXPECT_EQ(sized.invoke(SIZE_NAME), 3u);
+	EXPECT_FALSE(sized.invoke(EMPTY_NAME, sized));
+}
+
+TEST(PolyTest, ReadsAndWritesFields) {
+	auto tagged = Poly<Keyed>(Tagged{ "tagged", 1 });
+	auto item = Poly<Keyed>(WeightedItem{ { 0.5 }, { 2 } });
+	EXPECT_EQ(tagged.field(KEY_NAME), 1);
+	EXPECT_EQ(item.field(KEY_NAME), 2);
+
+	item.field(KEY_NAME) = 3;
+	EXPECT_EQ(item.unsafeGet<WeightedItem>()->key, 3);
+	EXPECT_EQ(item.unsafeGet<WeightedItem>()->weight, 0.5);
+	EXPECT_EQ(std::as_const(item).field(KEY_NAME), 3);
+	static_assert(std::is_same_v<decltype(std::as_const(item).field(KEY_NAME)), const int&>);
+
+	auto local = Poly<Keyed, RemoteStorage<>, caramel::poly::VTable<Local<Everything>>>(Tagged{ "local", 4 });
+	EXPECT_EQ(local.field(KEY_NAME), 4);
+
+	using SealedKeyed = Poly<
+		Keyed,
+		SealedStorage<Tagged, WeightedItem>,
+		caramel::poly::VTable<Sealed<Tagged, WeightedItem>>
+		>;
+	auto sealed = SealedKeyed(WeightedItem{ { 0.5 }, { 5 } });
+	EXPECT_EQ(sealed.field(KEY_NAME), 5);
+	const auto other = SealedKeyed(Tagged{ "sealed", 6 });
+	EXPECT_EQ(other.field(KEY_NAME), 6);
+}
+
+TEST(PolyTest, ReadsFieldsOfBaseClasses) {
+	auto derivedItem = Derived();
+	derivedItem.weight = 0.5;
+	derivedItem.key = 7;
+	auto derived = Poly<Keyed>(derivedItem);
+	EXPECT_EQ(derived.field(KEY_NAME), 7);
+	derived.field(KEY_NAME) = 8;
+	EXPECT_EQ(derived.unsafeGet<Derived>()->key, 8);
+	EXPECT_EQ(derived.unsafeGet<Derived>()->weight, 0.5);
+
+	// Members of the model itself are at a fixed offset even if it has virtual
+	// bases.
+	auto virtualItem = VirtualItem();
+	virtualItem.weight = 0.5;
+	virtualItem.key = 9;
+	auto item = Poly<Keyed>(virtualItem);
+	EXPECT_EQ(item.field(KEY_NAME), 9);
+	EXPECT_EQ(item.unsafeGet<VirtualItem>()->weight, 0.5);
+}
+
+TEST(PolyTest, ConstructsStorageFromResource) {
+	auto arena = Arena();
+
+	auto sp = Poly<Printable, ArenaStorage>(std::allocator_arg, arena, WithInt{ 42 });
+	EXPECT_EQ(sp.invoke(CONST_PRINT_NAME), "cprint:S:42"s);
+
+	auto moved = std::move(sp);
+	EXPECT_EQ(moved.invoke(CONST_PRINT_NAME), "cprint:S:42"s);
+
+	sp = Poly<Printable, ArenaStorage>(std::allocator_arg, arena, 12);
+	EXPECT_EQ(sp.invoke(CONST_PRINT_NAME), "cprint:int:12"s);
+	EXPECT_EQ(moved.invoke(CONST_PRINT_NAME), "cprint:S:42"s);
+}
+
+TEST(PolyTest, ConstructsStorageFromMemoryResource) {
+	auto buffer = std::pmr::monotonic_buffer_resource();
+
+	auto sp = Poly<Printable, PmrRemoteStorage>(std::allocator_arg, &buffer, WithInt{ 42 });
+	EXPECT_EQ(sp.invoke(CONST_PRINT_NAME), "cprint:S:42"s);
+}
+
 } // anonymous namespace
@@ -0,0 +1,208 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "caramel-poly/PolyCollection.hpp"
+
+namespace /* anonymous */ {
+
+using namespace caramel::poly;
+
+constexpr auto ACCUMULATE_NAME = POLY_FUNCTION_LABEL("accumulate");
+constexpr auto SCALE_NAME = POLY_FUNCTION_LABEL("scale");
+
+struct Accumulable : decltype(requires(
+	ACCUMULATE_NAME = method<void (std::vector<std::string>&) const>,
+	SCALE_NAME = function<void (SelfPlaceholder&, int)>
+	))
+{
+};
+
+constexpr auto ADVANCE_NAME = POLY_FUNCTION_LABEL("advance");
+constexpr auto SUM_NAME = POLY_FUNCTION_LABEL("sum");
+
+struct Movable : decltype(requires(
+	ADVANCE_NAME = batchMethod<void (float)>,
+	SUM_NAME = batchMethod<void (float&) const>
+	))
+{
+};
+
+struct Vectorized {
+	float position;
+
+	static int batches;
+};
+
+int Vectorized::batches = 0;
+
+struct Scalar {
+	float position;
+};
+
+struct Small {
+	int i;
+
+	void accumulate(std::vector<std::string>& out) const {
+		out.push_back("small:" + std::to_string(i));
+	}
+};
+
+struct Large {
+	std::string s;
+
+	void accumulate(std::vector<std::string>& out) const {
+		out.push_back("large:" + s);
+	}
+};
+
+struct alignas(32) OverAligned {
+	int i;
+
+	void accumulate(std::vector<std::string>& out) const {
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(this) % 32, 0u);
+		out.push_back("aligned:" + std::to_string(i));
+	}
+};
+
+} // anonymous namespace
+
+template <class T>
+constexpr auto caramel::poly::defaultConceptMap<Accumulable, T> = makeConceptMap(
+	ACCUMULATE_NAME = [](const T& self, std::vector<std::string>& out) { self.accumulate(out); },
+	SCALE_NAME = [](T&, int) {}
+	);
+
+template <>
+constexpr auto caramel::poly::conceptMap<Accumulable, Small> = makeConceptMap(
+	SCALE_NAME = [](Small& self, int factor) { self.i *= factor; }
+	);
+
+template <>
+constexpr auto caramel::poly::conceptMap<Movable, Vectorized> = makeConceptMap(
+	ADVANCE_NAME = [](Vectorized* objects, std::size_t count, float delta) {
+			++Vectorized::batches;
+			for (auto i = std::size_t(0); i != count; ++i) {
+				objects[i].position += delta;
+			}
+		},
+	SUM_NAME = [](const Vectorized* objects, std::size_t count, float& sum) {
+			for (auto i = std::size_t(0); i != count; ++i) {
+				sum += objects[i].position;
+			}
+		}
+	);
+
+template <>
+constexpr auto caramel::poly::conceptMap<Movable, Scalar> = makeConceptMap(
+	ADVANCE_NAME = [](Scalar& self, float delta) { self.position += 2 * delta; },
+	SUM_NAME = [](const Scalar& self, float& sum) { sum += self.position; }
+	);
+
+namespace /* anonymous */ {
+
+TEST(PolyCollectionTest, GroupsElementsByType) {
+	auto collection = PolyCollection<Accumulable>();
+	collection.insert(Small{ 1 });
+	collection.insert(Large{ "a" });
+	collection.emplace<Small>(Small{ 2 });
+	collection.insert(Large{ "b" });
+
+	EXPECT_EQ(collection.size(), 4u);
+	EXPECT_EQ(collection.size<Small>(), 2u);
+	EXPECT_EQ(collection.size<Large>(), 2u);
+	EXPECT_EQ(collection.size<OverAligned>(), 0u);
+	EXPECT_EQ(collection.segmentCount(), 2u);
+
+	auto out = std::vector<std::string>();
+	collection.invoke(ACCUMULATE_NAME, out);
+	EXPECT_EQ(out, (std::vector<std::string>{ "small:1", "small:2", "large:a", "large:b" }));
+}
+
+TEST(PolyCollectionTest, InvokesFunctionsTakingSelf) {
+	auto collection = PolyCollection<Accumulable>();
+	collection.insert(Small{ 1 });
+	collection.insert(Small{ 2 });
+
+	collection.invoke(SCALE_NAME, 3);
+
+	auto values = std::vector<int>();
+	collection.forEach<Small>([&values](const Small& s) { values.push_back(s.i); });
+	EXPECT_EQ(values, (std::vector<int>{ 3, 6 }));
+}
+
+TEST(PolyCollectionTest, KeepsElementsWhenSegmentsGrow) {
+	auto collection = PolyCollection<Accumulable>();
+	for (auto i = 0; i != 100; ++i) {
+		collection.insert(Large{ std::string(32, static_cast<char>('a' + i % 26)) + std::to_string(i) });
+		collection.insert(OverAligned{ i });
+	}
+
+	auto i = 0;
+	collection.forEach<Large>([&i](const Large& l) {
+			EXPECT_EQ(l.s, std::string(32, static_cast<char>('a' + i % 26)) + std::to_string(i));
+			++i;
+		});
+	EXPECT_EQ(i, 100);
+
+	auto out = std::vector<std::string>();
+	std::as_const(collection).invoke(ACCUMULATE_NAME, out);
+	EXPECT_EQ(out.size(), 200u);
+	EXPECT_EQ(out.back(), "aligned:99");
+}
+
+TEST(PolyCollectionTest, InsertsItsOwnElementsWhenSegmentsGrow) {
+	auto collection = PolyCollection<Accumulable>();
+	const auto& first = collection.insert(Large{ std::string(40, 'x') });
+	for (auto i = 1; i != 8; ++i) {
+		collection.insert(Large{ std::to_string(i) });
+	}
+
+	collection.insert(first);
+
+	auto values = std::vector<std::string>();
+	collection.forEach<Large>([&values](const Large& l) { values.push_back(l.s); });
+	ASSERT_EQ(values.size(), 9u);
+	EXPECT_EQ(values.front(), std::string(40, 'x'));
+	EXPECT_EQ(values.back(), std::string(40, 'x'));
+}
+
+TEST(PolyCollectionTest, ClearDestroysElements) {
+	auto collection = PolyCollection<Accumulable>();
+	collection.insert(Large{ "a" });
+	collection.clear();
+
+	EXPECT_TRUE(collection.empty());
+	EXPECT_EQ(collection.size<Large>(), 0u);
+
+	collection.insert(Large{ "b" });
+	auto moved = std::move(collection);
+	auto out = std::vector<std::string>();
+	moved.invoke(ACCUMULATE_NAME, out);
+	EXPECT_EQ(out, (std::vector<std::string>{ "large:b" }));
+}
+
+TEST(PolyCollectionTest, CallsBatchMethodsOncePerSegment) {
+	auto collection = PolyCollection<Movable>();
+	for (auto i = 0; i != 10; ++i) {
+		collection.insert(Vectorized{ 1.0f });
+		collection.insert(Scalar{ 1.0f });
+	}
+
+	Vectorized::batches = 0;
+	collection.invoke(ADVANCE_NAME, 0.5f);
+	EXPECT_EQ(Vectorized::batches, 1);
+
+	auto sum = 0.0f;
+	std::as_const(collection).invoke(SUM_NAME, sum);
+	EXPECT_FLOAT_EQ(sum, 10 * 1.5f + 10 * 2.0f);
+}
+
+} // anonymous namespace
@@ -0,0 +1,151 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "caramel-poly/PolySequence.hpp"
+
+namespace /* anonymous */ {
+
+using namespace caramel::poly;
+
+constexpr auto EXECUTE_NAME = POLY_FUNCTION_LABEL("execute");
+constexpr auto DESCRIBE_NAME = POLY_FUNCTION_LABEL("describe");
+
+struct Command : decltype(requires(
+	EXECUTE_NAME = method<void (int&)>,
+	DESCRIBE_NAME = method<void (std::vector<std::string>&) const>
+	))
+{
+};
+
+struct Add {
+	int amount;
+
+	void execute(int& target) {
+		target += amount;
+	}
+
+	void describe(std::vector<std::string>& out) const {
+		out.push_back("add " + std::to_string(amount));
+	}
+};
+
+struct Multiply {
+	char factor;
+
+	void execute(int& target) {
+		target *= factor;
+	}
+
+	void describe(std::vector<std::string>& out) const {
+		out.push_back("multiply " + std::to_string(factor));
+	}
+};
+
+struct Log {
+	std::string message;
+
+	void execute(int&) {
+		message += "!";
+	}
+
+	void describe(std::vector<std::string>& out) const {
+		out.push_back(message);
+	}
+};
+
+} // anonymous namespace
+
+template <class T>
+constexpr auto caramel::poly::defaultConceptMap<Command, T> = makeConceptMap(
+	EXECUTE_NAME = [](T& self, int& target) { self.execute(target); },
+	DESCRIBE_NAME = [](const T& self, std::vector<std::string>& out) { self.describe(out); }
+	);
+
+namespace /* anonymous */ {
+
+TEST(PolySequenceTest, InvokesInInsertionOrder) {
+	auto sequence = PolySequence<Command>();
+	sequence.pushBack(Add{ 1 });
+	sequence.pushBack(Multiply{ 3 });
+	sequence.emplaceBack<Add>(Add{ 2 });
+	sequence.pushBack(Multiply{ 2 });
+
+	EXPECT_EQ(sequence.size(), 4u);
+
+	auto value = 0;
+	sequence.invoke(EXECUTE_NAME, value);
+	EXPECT_EQ(value, ((0 + 1) * 3 + 2) * 2);
+
+	auto out = std::vector<std::string>();
+	std::as_const(sequence).invoke(DESCRIBE_NAME, out);
+	EXPECT_EQ(out, (std::vector<std::string>{ "add 1", "multiply 3", "add 2", "multiply 2" }));
+}
+
+TEST(PolySequenceTest, PacksObjectsBehindHeaders) {
+	auto sequence = PolySequence<Command>();
+	sequence.pushBack(Multiply{ 1 });
+	sequence.pushBack(Multiply{ 2 });
+
+	// A remote vtable and two offsets, followed by the object padded to the
+	// alignment of the next header.
+	EXPECT_EQ(sequence.byteSize(), 2 * (sizeof(void*) + 2 * sizeof(std::uint32_t) + alignof(void*)));
+}
+
+TEST(PolySequenceTest, RelocatesObjectsWhenGrowing) {
+	auto sequence = PolySequence<Command, VTable<Local<Everything>>>();
+	for (auto i = 0; i != 100; ++i) {
+		sequence.pushBack(Log{ std::string(32, static_cast<char>('a' + i % 26)) });
+		sequence.pushBack(Add{ i });
+	}
+
+	auto value = 0;
+	sequence.invoke(EXECUTE_NAME, value);
+	EXPECT_EQ(value, 99 * 100 / 2);
+
+	auto out = std::vector<std::string>();
+	sequence.invoke(DESCRIBE_NAME, out);
+	ASSERT_EQ(out.size(), 200u);
+	EXPECT_EQ(out[2], std::string(32, 'b') + "!");
+	EXPECT_EQ(out[199], "add 99");
+}
+
+TEST(PolySequenceTest, PushesItsOwnObjectsWhenGrowing) {
+	auto sequence = PolySequence<Command>();
+	const auto& first = sequence.pushBack(Log{ std::string(40, 'x') });
+	const auto capacity = sequence.capacity();
+	while (sequence.capacity() == capacity) {
+		sequence.pushBack(first);
+	}
+
+	auto out = std::vector<std::string>();
+	sequence.invoke(DESCRIBE_NAME, out);
+	ASSERT_GT(out.size(), 2u);
+	EXPECT_EQ(out.back(), std::string(40, 'x'));
+}
+
+TEST(PolySequenceTest, ClearKeepsTheBuffer) {
+	auto sequence = PolySequence<Command>();
+	sequence.pushBack(Log{ "log" });
+	const auto capacity = sequence.capacity();
+	sequence.clear();
+
+	EXPECT_TRUE(sequence.empty());
+	EXPECT_EQ(sequence.byteSize(), 0u);
+	EXPECT_EQ(sequence.capacity(), capacity);
+
+	sequence.pushBack(Log{ "other" });
+	auto moved = std::move(sequence);
+	auto out = std::vector<std::string>();
+	moved.invoke(DESCRIBE_NAME, out);
+	EXPECT_EQ(out, (std::vector<std::string>{ "other" }));
+	EXPECT_TRUE(sequence.empty());
+}
+
+} // anonymous namespace
@@ -0,0 +1,125 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "caramel-poly/PoolAllocator.hpp"
+
+namespace /* anonymous */ {
+
+using namespace caramel::poly;
+
+bool isMaxAligned(void* ptr) {
+	return reinterpret_cast<std::uintptr_t>(ptr) % alignof(std::max_align_t) == 0;
+}
+
+TEST(PoolAllocatorTest, ReusesFreedBlocks) {
+	using Allocator = PoolAllocator<>;
+
+	auto* first = Allocator::allocate(24);
+	ASSERT_NE(first, nullptr);
+	Allocator::free(first);
+
+	auto* second = Allocator::allocate(24);
+	EXPECT_EQ(second, first);
+	Allocator::free(second);
+}
+
+TEST(PoolAllocatorTest, RoundsRequestsUpToSizeClass) {
+	using Allocator = PoolAllocator<>;
+	constexpr auto granularity = alignof(std::max_align_t);
+
+	auto* small = Allocator::allocate(granularity + 1);
+	Allocator::free(small);
+
+	auto* large = Allocator::allocate(2 * granularity);
+	EXPECT_EQ(large, small);
+	Allocator::free(large);
+}
+
+TEST(PoolAllocatorTest, ReturnsAlignedBlocks) {
+	using Allocator = PoolAllocator<>;
+
+	auto blocks = std::vector<void*>();
+	for (std::size_t size = 1; size <= 512; size += 7) {
+		auto* block = Allocator::allocate(size);
+		ASSERT_NE(block, nullptr);
+		EXPECT_TRUE(isMaxAligned(block));
+		blocks.push_back(block);
+	}
+
+	for (auto* block : blocks) {
+		Allocator::free(block);
+	}
+}
+
+TEST(PoolAllocatorTest, ServesOversizedRequests) {
+	using Allocator = PoolAllocator<64, 1024>;
+
+	auto* block = static_cast<unsigned char*>(Allocator::allocate(4096));
+	ASSERT_NE(block, nullptr);
+	EXPECT_TRUE(isMaxAligned(block));
+	block[0] = 1;
+	block[4095] = 2;
+	Allocator::free(block);
+}
+
+TEST(PoolAllocatorTest, ReclaimsBlocksFreedByOtherThreads) {
+	using Allocator = PoolAllocator<64, 1024>;
+
+	auto* block = Allocator::allocate(48);
+	ASSERT_NE(block, nullptr);
+
+	std::thread([block]() { Allocator::free(block); }).join();
+
+	// The block sits on the remote list until the local free list runs dry.
+	auto allocated = std::vector<void*>();
+	auto reclaimed = false;
+	for (auto i = 0; i != 1024 && !reclaimed; ++i) {
+		allocated.push_back(Allocator::allocate(48));
+		reclaimed = (allocated.back() == block);
+	}
+
+	EXPECT_TRUE(reclaimed);
+
+	for (auto* ptr : allocated) {
+		Allocator::free(ptr);
+	}
+}
+
+TEST(PoolAllocatorTest, OutlivesAllocatingThread) {
+	using Allocator = PoolAllocator<128, 2048>;
+
+	auto* block = static_cast<int*>(nullptr);
+	std::thread([&block]() {
+			block = static_cast<int*>(Allocator::allocate(sizeof(int)));
+			*block = 42;
+		}).join();
+
+	ASSERT_NE(block, nullptr);
+	EXPECT_EQ(*block, 42);
+	Allocator::free(block);
+
+	// The exited thread's cache is adopted by the next thread needing one.
+	std::thread([]() {
+			auto* other = Allocator::allocate(sizeof(int));
+			EXPECT_NE(other, nullptr);
+			Allocator::free(other);
+		}).join();
+}
+
+TEST(PoolAllocatorTest, MakesSharedObjects) {
+	using Allocator = PoolAllocator<>;
+
+	auto ptr = Allocator::makeShared<std::vector<int>>(3, 7);
+	ASSERT_NE(ptr, nullptr);
+	EXPECT_EQ(ptr->size(), 3u);
+	EXPECT_EQ((*ptr)[2], 7);
+}
+
+} // anonymous namespace
@@ -0,0 +1,148 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "caramel-poly/Poly.hpp"
+#include "caramel-poly/RelocatingVector.hpp"
+
+namespace /* anonymous */ {
+
+using namespace caramel::poly;
+
+constexpr auto VALUE_NAME = POLY_FUNCTION_LABEL("value");
+
+struct Valued : decltype(requires(
+	MoveConstructible{},
+	VALUE_NAME = method<int () const>
+	))
+{
+};
+
+struct Value {
+	int i;
+};
+
+int copiesBeforeThrow = -1;
+
+// Copying throws once `copiesBeforeThrow` copies have been made.
+struct FragileCopy {
+	std::string s;
+
+	explicit FragileCopy(std::string str) :
+		s(std::move(str))
+	{
+	}
+
+	FragileCopy(FragileCopy&& other) noexcept(false) :
+		s(std::move(other.s))
+	{
+	}
+
+	FragileCopy(const FragileCopy& other) :
+		s(other.s)
+	{
+		if (copiesBeforeThrow-- == 0) {
+			throw std::runtime_error("copy");
+		}
+	}
+};
+
+} // anonymous namespace
+
+template <class T>
+constexpr auto caramel::poly::defaultConceptMap<Valued, T> = makeConceptMap(
+	VALUE_NAME = [](const auto& v) { return v.i; }
+	);
+
+namespace /* anonymous */ {
+
+using RemotePoly = Poly<Valued, RemoteStorage<>>;
+using LocalPoly = Poly<Valued, SBOStorage<16>, VTable<Local<Everything>>>;
+
+TEST(RelocationTest, RecognisesTriviallyRelocatablePolys) {
+	static_assert(isTriviallyRelocatable<RemotePoly>);
+	static_assert(isTriviallyRelocatable<Poly<Valued, SharedRemoteStorage<>>>);
+	static_assert(isTriviallyRelocatable<Poly<Valued, NonOwningStorage, VTable<Local<Everything>>>>);
+	static_assert(!isTriviallyRelocatable<LocalPoly>);
+	static_assert(!isTriviallyRelocatable<std::string>);
+}
+
+TEST(RelocationTest, PolyMovesAreNoexceptWithPointerStorage) {
+	static_assert(std::is_nothrow_move_constructible_v<RemotePoly>);
+	static_assert(std::is_nothrow_move_assignable_v<RemotePoly>);
+	static_assert(std::is_nothrow_swappable_v<RemotePoly>);
+	static_assert(!std::is_nothrow_move_constructible_v<LocalPoly>);
+}
+
+template <class P>
+void checkGrowth() {
+	auto polys = RelocatingVector<P>();
+	for (auto i = 0; i != 100; ++i) {
+		polys.emplaceBack(Value{ i });
+	}
+
+	ASSERT_EQ(polys.size(), 100u);
+	EXPECT_GE(polys.capacity(), 100u);
+	for (auto i = 0; i != 100; ++i) {
+		EXPECT_EQ(polys[i].invoke(VALUE_NAME), i);
+	}
+
+	polys.popBack();
+	EXPECT_EQ(polys.size(), 99u);
+}
+
+TEST(RelocatingVectorTest, GrowsWithTriviallyRelocatableElements) {
+	checkGrowth<RemotePoly>();
+}
+
+TEST(RelocatingVectorTest, GrowsWithOtherElements) {
+	checkGrowth<LocalPoly>();
+
+	auto strings = RelocatingVector<std::string>();
+	for (auto i = 0; i != 20; ++i) {
+		strings.pushBack(std::string(32, static_cast<char>('a' + i)));
+	}
+	EXPECT_EQ(strings[19], std::string(32, 't'));
+}
+
+TEST(RelocatingVectorTest, PushesItsOwnElementsAtCapacity) {
+	auto strings = RelocatingVector<std::string>();
+	strings.pushBack(std::string(40, 'x'));
+	ASSERT_EQ(strings.size(), strings.capacity());
+	strings.pushBack(strings[0]);
+	EXPECT_EQ(strings[1], std::string(40, 'x'));
+
+	strings.pushBack(std::string(40, 'y'));
+	strings.pushBack(std::string(40, 'z'));
+	ASSERT_EQ(strings.size(), strings.capacity());
+	strings.emplaceBack(strings[2], 0, 20);
+	EXPECT_EQ(strings[4], std::string(20, 'y'));
+	EXPECT_EQ(strings[0], std::string(40, 'x'));
+}
+
+TEST(RelocatingVectorTest, IsLeftUnchangedWhenGrowthThrows) {
+	static_assert(!isCopyConstructible<LocalPoly>);
+	static_assert(isCopyConstructible<Poly<decltype(requires(Valued{}, CopyConstructible{})), SBOStorage<16>>>);
+
+	auto elements = RelocatingVector<FragileCopy>();
+	for (auto i = 0; i != 4; ++i) {
+		elements.pushBack(FragileCopy(std::string(32, static_cast<char>('a' + i))));
+	}
+	ASSERT_EQ(elements.size(), elements.capacity());
+
+	copiesBeforeThrow = 2;
+	EXPECT_THROW(elements.pushBack(FragileCopy(std::string(32, 'e'))), std::runtime_error);
+	copiesBeforeThrow = -1;
+
+	ASSERT_EQ(elements.size(), 4u);
+	for (auto i = 0; i != 4; ++i) {
+		EXPECT_EQ(elements[i].s, std::string(32, static_cast<char>('a' + i)));
+	}
+}
+
+} // anonymous namespace
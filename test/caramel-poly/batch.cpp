@@ -0,0 +1,193 @@
+// Copyright Mikolaj Radwan 2018
+// Distributed under the MIT license (See accompanying file LICENSE)
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "caramel-poly/batch.hpp"
+
+namespace /* anonymous */ {
+
+using namespace caramel::poly;
+
+constexpr auto RECORD_NAME = POLY_FUNCTION_LABEL("record");
+constexpr auto BUMP_NAME = POLY_FUNCTION_LABEL("bump");
+
+struct Recordable : decltype(requires(
+	RECORD_NAME = method<void (std::vector<std::string>&) const>,
+	BUMP_NAME = function<void (SelfPlaceholder&, int)>
+	))
+{
+};
+
+constexpr auto INDEX_NAME = POLY_FUNCTION_LABEL("index");
+
+struct Indexable : decltype(requires(
+	INDEX_NAME = method<void (std::vector<int>&) const>
+	))
+{
+};
+
+template <int I>
+struct Numbered {
+};
+
+struct First {
+	int i;
+};
+
+struct Second {
+	int i;
+};
+
+struct Third {
+	int i;
+};
+
+template <class T>
+std::string describe(const T& t);
+
+template <>
+std::string describe(const First& t) {
+	return "first:" + std::to_string(t.i);
+}
+
+template <>
+std::string describe(const Second& t) {
+	return "second:" + std::to_string(t.i);
+}
+
+template <>
+std::string describe(const Third& t) {
+	return "third:" + std::to_string(t.i);
+}
+
+} // anonymous namespace
+
+template <class T>
+constexpr auto caramel::poly::defaultConceptMap<Recordable, T> = makeConceptMap(
+	RECORD_NAME = [](const T& self, std::vector<std::string>& out) { out.push_back(describe(self)); },
+	BUMP_NAME = [](T& self, int amount) { self.i += amount; }
+	);
+
+template <int I>
+constexpr auto caramel::poly::conceptMap<Indexable, Numbered<I>> = makeConceptMap(
+	INDEX_NAME = [](const Numbered<I>&, std::vector<int>& out) { out.push_back(I); }
+	);
+
+namespace /* anonymous */ {
+
+using RecordablePoly = Poly<Recordable>;
+
+std::vector<RecordablePoly> makePolys() {
+	auto polys = std::vector<RecordablePoly>();
+	polys.emplace_back(First{ 0 });
+	polys.emplace_back(Second{ 1 });
+	polys.emplace_back(First{ 2 });
+	polys.emplace_back(Third{ 3 });
+	polys.emplace_back(Second{ 4 });
+	return polys;
+}
+
+TEST(BatchTest, InvokeAllGroupsCallsByType) {
+	const auto polys = makePolys();
+
+	auto out = std::vector<std::string>();
+	invokeAll(polys, RECORD_NAME, out);
+
+	EXPECT_EQ(out, (std::vector<std::string>{ "first:0", "first:2", "second:1", "second:4", "third:3" }));
+}
+
+TEST(BatchTest, InvokeAllInOrderKeepsTheOrder) {
+	const auto polys = makePolys();
+
+	auto out = std::vector<std::string>();
+	invokeAll(inOrder, polys, RECORD_NAME, out);
+
+	EXPECT_EQ(out, (std::vector<std::string>{ "first:0", "second:1", "first:2", "third:3", "second:4" }));
+}
+
+TEST(BatchTest, InvokeAllModifiesElements) {
+	auto polys = makePolys();
+	invokeAll(polys, BUMP_NAME, 10);
+
+	auto list = std::list<RecordablePoly>();
+	for (auto& poly : polys) {
+		list.push_back(std::move(poly));
+	}
+	invokeAll(inOrder, list, BUMP_NAME, 100);
+
+	auto out = std::vector<std::string>();
+	invokeAll(inOrder, list, RECORD_NAME, out);
+	EXPECT_EQ(out, (std::vector<std::string>{ "first:110", "second:111", "first:112", "third:113", "second:114" }));
+}
+
+TEST(BatchTest, InvokeAllGroupsCallsOnSealedVTables) {
+	using SealedRecordablePoly = Poly<
+		Recordable,
+		SealedStorage<First, Second, Third>,
+		caramel::poly::VTable<Sealed<First, Second, Third>>
+		>;
+	auto polys = std::list<SealedRecordablePoly>();
+	polys.emplace_back(Second{ 0 });
+	polys.emplace_back(First{ 1 });
+	polys.emplace_back(Second{ 2 });
+	polys.emplace_back(Third{ 3 });
+
+	invokeAll(polys, BUMP_NAME, 10);
+
+	auto out = std::vector<std::string>();
+	invokeAll(polys, RECORD_NAME, out);
+	EXPECT_EQ(out, (std::vector<std::string>{ "second:10", "second:12", "first:11", "third:13" }));
+}
+
+TEST(BatchTest, InvokeAllKeepsObjectsSharedForConstMethods) {
+	struct CopyableRecordable : decltype(requires(Recordable{}, CopyConstructible{})) {
+	};
+	using CowRecordablePoly = Poly<CopyableRecordable, CowStorage<NonAtomicRefCount>>;
+
+	const auto original = CowRecordablePoly(First{ 0 });
+	auto polys = std::vector<CowRecordablePoly>{ original, original };
+
+	auto out = std::vector<std::string>();
+	invokeAll(polys, RECORD_NAME, out);
+	invokeAll(inOrder, polys, RECORD_NAME, out);
+
+	EXPECT_EQ(out.size(), 4u);
+	for (const auto& poly : polys) {
+		EXPECT_EQ(poly.unsafeGet<First>(), original.unsafeGet<First>());
+	}
+}
+
+template <int... I>
+void addNumbered(std::vector<Poly<Indexable>>& polys, std::integer_sequence<int, I...>) {
+	(polys.emplace_back(Numbered<I>{}), ...);
+}
+
+TEST(BatchTest, InvokeAllHandlesManyTypes) {
+	auto polys = std::vector<Poly<Indexable>>();
+	addNumbered(polys, std::make_integer_sequence<int, 40>{});
+	addNumbered(polys, std::make_integer_sequence<int, 40>{});
+
+	auto out = std::vector<int>();
+	invokeAll(polys, INDEX_NAME, out);
+
+	ASSERT_EQ(out.size(), 80u);
+	for (auto i = 0; i != 40; ++i) {
+		EXPECT_EQ(out[2 * i], i);
+		EXPECT_EQ(out[2 * i + 1], i);
+	}
+}
+
+TEST(BatchTest, InvokeAllHandlesEmptyRanges) {
+	auto polys = std::vector<RecordablePoly>();
+	auto out = std::vector<std::string>();
+	invokeAll(polys, RECORD_NAME, out);
+	EXPECT_TRUE(out.empty());
+}
+
+} // anonymous namespace
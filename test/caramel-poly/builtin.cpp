@@ -3,7 +3,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <string>
+#include <typeinfo>
+#include <utility>
 
 #include "caramel-poly/Poly.hpp"
 
@@ -14,6 +17,54 @@ using namespace caramel::poly;
 struct Empty {
 };
 
+struct Trivial {
+	int i;
+};
+
+struct ThrowingMove {
+	ThrowingMove() = default;
+	ThrowingMove(ThrowingMove&&) noexcept(false) {
+	}
+};
+
+int trivialDestructions = 0;
+
+struct CustomMove {
+	std::string s;
+};
+
+int customMoves = 0;
+
+constexpr auto ID_LABEL = POLY_FUNCTION_LABEL("id");
+
+struct Identified : decltype(requires(
+	ID_LABEL = constant<std::uint32_t>
+	))
+{
+};
+
+} // anonymous namespace
+
+template <>
+auto const caramel::poly::conceptMap<Destructible, Trivial> = makeConceptMap(
+	DESTRUCT_LABEL = [](Trivial&) { ++trivialDestructions; }
+	);
+
+template <>
+auto const caramel::poly::conceptMap<MoveConstructible, CustomMove> = makeConceptMap(
+	MOVE_CONSTRUCT_LABEL = [](void* p, CustomMove&& other) {
+		++customMoves;
+		new (p) CustomMove(std::move(other));
+	}
+	);
+
+template <>
+auto const caramel::poly::conceptMap<Identified, Trivial> = makeConceptMap(
+	ID_LABEL = []() { return std::uint32_t(42); }
+	);
+
+namespace /* anonymous */ {
+
 TEST(PolyTest, TypeIdAccessible) {
 	auto sp = Poly<TypeId>{Empty{}};
 
@@ -26,4 +77,95 @@ TEST(PolyTest, TypeIdAccessible) {
 	EXPECT_EQ(reportedTypeid, expectedTypeid);
 }
 
+TEST(BuiltinTest, HoldsConstantsInVTables) {
+	using Table = VTable<Local<Everything>>::Type<decltype(requires(Storable{}, TypeId{}))>;
+	constexpr auto table = Table{completeConceptMap<decltype(requires(Storable{}, TypeId{})), Trivial>(
+		conceptMap<decltype(requires(Storable{}, TypeId{})), Trivial>)};
+
+	static_assert(table[STORAGE_INFO_LABEL] == storageInfoFor<Trivial>);
+	static_assert(table[STORAGE_INFO_LABEL].triviallyCopyable);
+	static_assert(table[STORAGE_INFO_LABEL].triviallyDestructible);
+	EXPECT_EQ(*table[TYPEID_LABEL], typeid(Trivial));
+
+	auto sp = Poly<Identified>{Trivial{ 1 }};
+	EXPECT_EQ(sp.virtual_(ID_LABEL)(), 42u);
+	EXPECT_EQ(detail::PolyAccess::vtable(sp)[ID_LABEL], 42u);
+}
+
+TEST(BuiltinTest, SkipsDestructorsOfTriviallyDestructibleObjects) {
+	trivialDestructions = 0;
+	{
+		auto sp = Poly<TypeId>{Trivial{ 1 }};
+		EXPECT_EQ(sp.virtual_(TYPEID_LABEL)(), typeid(Trivial));
+	}
+	EXPECT_EQ(trivialDestructions, 0);
+}
+
+TEST(BuiltinTest, RelocatesObjects) {
+	static_assert(models<Relocatable, std::string>);
+
+	const auto complete = completeConceptMap<Relocatable, std::string>(conceptMap<Relocatable, std::string>);
+	auto relocate = complete[RELOCATE_LABEL];
+
+	alignas(std::string) unsigned char from[sizeof(std::string)];
+	alignas(std::string) unsigned char to[sizeof(std::string)];
+	auto* source = new (from) std::string(100, 'x');
+
+	relocate(to, std::move(*source));
+
+	auto* target = reinterpret_cast<std::string*>(to);
+	EXPECT_EQ(*target, std::string(100, 'x'));
+	target->~basic_string();
+}
+
+TEST(BuiltinTest, ErasesNothrowMovesAndDestructorsAsNoexcept) {
+	using Table = VTable<Local<Everything>>::Type<MoveConstructible>;
+	const auto nothrow = Table{completeConceptMap<MoveConstructible, std::string>(
+		conceptMap<MoveConstructible, std::string>)};
+	const auto throwing = Table{completeConceptMap<MoveConstructible, ThrowingMove>(
+		conceptMap<MoveConstructible, ThrowingMove>)};
+
+	const auto nothrowMove = completeConceptMap<MoveConstructible, std::string>(
+		conceptMap<MoveConstructible, std::string>)[MOVE_CONSTRUCT_LABEL];
+	const auto throwingMove = completeConceptMap<MoveConstructible, ThrowingMove>(
+		conceptMap<MoveConstructible, ThrowingMove>)[MOVE_CONSTRUCT_LABEL];
+	static_assert(detail::isNoexceptSignature<decltype(detail::EraseFunction<
+		void (void*, SelfPlaceholder&&)>(nothrowMove))>);
+	static_assert(!detail::isNoexceptSignature<decltype(detail::EraseFunction<
+		void (void*, SelfPlaceholder&&)>(throwingMove))>);
+	EXPECT_NE(nothrow[MOVE_CONSTRUCT_LABEL], throwing[MOVE_CONSTRUCT_LABEL]);
+
+	const auto destruct = completeConceptMap<Destructible, ThrowingMove>(
+		conceptMap<Destructible, ThrowingMove>)[DESTRUCT_LABEL];
+	static_assert(detail::isNoexceptSignature<decltype(detail::EraseFunction<
+		void (SelfPlaceholder&) noexcept>(destruct))>);
+	static_assert(detail::isNoexceptSignature<decltype(
+		std::declval<VTable<Local<Everything>>::Type<Destructible>>()[DESTRUCT_LABEL])>);
+}
+
+TEST(BuiltinTest, MoveConstructibleRefinesRelocatable) {
+	static_assert(contains(detail::clauseNames(MoveConstructible{}), RELOCATE_LABEL));
+}
+
+TEST(BuiltinTest, RelocatesThroughCustomMoveConstructors) {
+	using Concept = decltype(requires(Storable{}, Destructible{}, MoveConstructible{}));
+	using SBOPoly = Poly<Concept, SBOStorage<sizeof(CustomMove)>>;
+
+	customMoves = 0;
+	auto sp = SBOPoly{CustomMove{ "custom" }};
+	const auto moves = customMoves;
+
+	auto moved = SBOPoly{std::move(sp)};
+	EXPECT_EQ(customMoves, moves + 1);
+	EXPECT_EQ(moved.unsafeGet<CustomMove>()->s, "custom");
+
+	auto other = SBOPoly{CustomMove{ "other" }};
+	const auto beforeSwap = customMoves;
+	using std::swap;
+	swap(moved, other);
+	EXPECT_GT(customMoves, beforeSwap);
+	EXPECT_EQ(moved.unsafeGet<CustomMove>()->s, "other");
+	EXPECT_EQ(other.unsafeGet<CustomMove>()->s, "custom");
+}
+
 } // anonymous namespace
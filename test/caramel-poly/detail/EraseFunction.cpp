@@ -36,4 +36,17 @@ TEST(EraseFunctionTest, ErasesPlaceholdersFromLambda) {
 	EXPECT_EQ(r, &s2);
 }
 
+TEST(EraseFunctionTest, ErasesNoexceptFunctions) {
+	auto throwing = [](S& s) { return s.i; };
+	auto nothrow = [](S& s) noexcept { return s.i; };
+
+	const auto erased = EraseFunction<int (SelfPlaceholder&) noexcept>(throwing);
+	static_assert(std::is_same_v<decltype(erased), int (* const)(void*) noexcept>);
+	static_assert(std::is_same_v<decltype(EraseFunction<int (SelfPlaceholder&)>(nothrow)), int (*)(void*) noexcept>);
+	static_assert(std::is_same_v<decltype(EraseFunction<int (SelfPlaceholder&)>(throwing)), int (*)(void*)>);
+
+	auto s = S{ 42 };
+	EXPECT_EQ(erased(&s), 42);
+}
+
 } // anonymous namespace
@@ -41,4 +41,14 @@ TEST(TransformSignatureTest, AppliesMetafunctionToAllTypesInSignature) {
 	static_assert(std::is_same_v<TransformedResult, Converted<int&>>);
 }
 
+TEST(TransformSignatureTest, KeepsNoexceptSpecifier) {
+	using Signature = int& (char&&, void*) noexcept;
+	using TransformedSignature = TransformSignature<Signature, Metafunction>::Type;
+	using ExpectedTransformedSignature = Converted<int&> (Converted<char&&>, Converted<void*>) noexcept;
+
+	static_assert(std::is_same_v<TransformedSignature, ExpectedTransformedSignature>);
+	static_assert(isNoexceptSignature<TransformedSignature>);
+	static_assert(!isNoexceptSignature<RemoveNoexcept<TransformedSignature>::Type>);
+}
+
 } // anonymous namespace
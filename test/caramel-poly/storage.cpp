@@ -4,10 +4,15 @@
 #include <gtest/gtest.h>
 #include <gtest/gtest-typed-test.h>
 
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
 #include <type_traits>
 
 #include "caramel-poly/vtable.hpp"
 #include "caramel-poly/storage.hpp"
+#include "caramel-poly/PoolAllocator.hpp"
 #include "../ConstructionRegistry.hpp"
 
 namespace /* anonymous */ {
@@ -28,6 +33,33 @@ struct ObjectInterface : decltype(caramel::poly::requires(
 {
 };
 
+// The object held by `storage`, which some storages (like `CompactSBOStorage`)
+// can only find given its vtable.
+template <class Storage, class VTable, class = void>
+constexpr bool findsObjectByVTable = false;
+
+template <class Storage, class VTable>
+constexpr bool findsObjectByVTable<
+	Storage,
+	VTable,
+	std::void_t<decltype(std::declval<const Storage&>().get(std::declval<const VTable&>()))>
+	> = true;
+
+template <class T, class Storage, class VTable>
+T* objectIn(Storage& storage, const VTable& vtable) {
+	if constexpr (findsObjectByVTable<Storage, VTable>) {
+		return const_cast<T*>(std::as_const(storage).template get<T>(vtable));
+	} else {
+		return storage.template get<T>();
+	}
+}
+
+template <class T>
+auto localVTableFor() {
+	const auto complete = completeConceptMap<ObjectInterface, T>(conceptMap<ObjectInterface, T>);
+	return VTable<Local<Everything>>::Type<ObjectInterface>{complete};
+}
+
 TEST(SBOStorageTest, StoresFittingDataInternally) {
 	auto smallStorage = SBOStorage<sizeof(void*)>(S<1>{});
 	auto* firstByte = reinterpret_cast<char*>(smallStorage.template get<S<1>>());
@@ -44,6 +76,88 @@ TEST(SBOStorageTest, StoresNonFittingDataExternally) {
 		);
 }
 
+TEST(CompactSBOStorageTest, IsAsLargeAsItsBuffer) {
+	static_assert(sizeof(CompactSBOStorage<16>) == 16);
+	static_assert(sizeof(CompactSBOStorage<24>) == 24);
+	static_assert(sizeof(CompactSBOStorage<16>) < sizeof(SBOStorage<16>));
+}
+
+TEST(CompactSBOStorageTest, StoresFittingDataInternally) {
+	using Object = std::array<char, 2 * sizeof(void*)>;
+	auto storage = CompactSBOStorage<2 * sizeof(void*)>(Object{ 'a' });
+	auto* firstByte = std::as_const(storage).template get<char>(localVTableFor<Object>());
+	EXPECT_EQ(*firstByte, 'a');
+	EXPECT_GE(firstByte, reinterpret_cast<char*>(&storage));
+	EXPECT_LT(firstByte, reinterpret_cast<char*>(&storage) + sizeof(storage));
+}
+
+TEST(CompactSBOStorageTest, StoresPointerAlignedDataOfItsWholeSizeInternally) {
+	static_assert(CompactSBOStorage<16>::canStore(storageInfoFor<S<16 / sizeof(void*)>>));
+	static_assert(CompactSBOStorage<24>::canStore(storageInfoFor<S<24 / sizeof(void*)>>));
+	static_assert(!CompactSBOStorage<16>::canStore(storageInfoFor<S<16 / sizeof(void*) + 1>>));
+
+	using Object = S<16 / sizeof(void*)>;
+	auto value = 0;
+	auto storage = CompactSBOStorage<16>(Object{ { &value } });
+	const auto* object = std::as_const(storage).template get<Object>(localVTableFor<Object>());
+	EXPECT_EQ(static_cast<const void*>(object), static_cast<const void*>(&storage));
+	EXPECT_EQ(object->p[0], &value);
+}
+
+TEST(CompactSBOStorageTest, StoresNonFittingDataExternally) {
+	auto storage = CompactSBOStorage<2 * sizeof(void*)>(S<3>{});
+	auto* firstByte = reinterpret_cast<const char*>(
+		std::as_const(storage).template get<S<3>>(localVTableFor<S<3>>()));
+	EXPECT_TRUE(
+		firstByte < reinterpret_cast<char*>(&storage) ||
+		firstByte >= reinterpret_cast<char*>(&storage) + sizeof(storage)
+		);
+}
+
+struct alignas(32) OverAligned {
+	float values[8];
+};
+
+bool isAligned(const void* ptr, std::size_t alignment) {
+	return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(AlignedSBOStorageTest, StoresOverAlignedDataInternally) {
+	static_assert(alignof(AlignedSBOStorage<sizeof(OverAligned), 32>) < 32);
+
+	auto storage = AlignedSBOStorage<sizeof(OverAligned), 32>(OverAligned{ { 1.0f } });
+	auto* object = storage.template get<OverAligned>();
+	EXPECT_TRUE(isAligned(object, 32));
+	EXPECT_EQ(object->values[0], 1.0f);
+
+	auto* firstByte = reinterpret_cast<char*>(object);
+	EXPECT_GE(firstByte, reinterpret_cast<char*>(&storage));
+	EXPECT_LT(firstByte, reinterpret_cast<char*>(&storage) + sizeof(storage));
+}
+
+TEST(AlignedSBOStorageTest, StoresNonFittingDataExternally) {
+	auto storage = AlignedSBOStorage<sizeof(void*)>(S<2>{});
+	auto* firstByte = reinterpret_cast<char*>(storage.template get<S<2>>());
+	EXPECT_TRUE(
+		firstByte < reinterpret_cast<char*>(&storage) ||
+		firstByte >= reinterpret_cast<char*>(&storage) + sizeof(storage)
+		);
+}
+
+TEST(AlignedLocalStorageTest, StoresOverAlignedDataAtAnyStorageAddress) {
+	using Storage = AlignedLocalStorage<sizeof(OverAligned), 32>;
+	static_assert(alignof(Storage) < 32);
+
+	alignas(32) unsigned char memory[32 + sizeof(Storage)];
+	for (auto offset = std::size_t(0); offset < 32; offset += alignof(Storage)) {
+		auto* storage = new (memory + offset) Storage(OverAligned{ { 1.0f } });
+		auto* object = storage->template get<OverAligned>();
+		EXPECT_TRUE(isAligned(object, 32));
+		EXPECT_EQ(object->values[0], 1.0f);
+		storage->~Storage();
+	}
+}
+
 template <class T>
 struct AllStorageTest : ::testing::Test {};
 template <class T>
@@ -63,6 +177,10 @@ struct StorageScenario {
 
 using SmallObject = test::ConstructionRegistry::Object;
 
+struct alignas(32) OverAlignedObject : test::ConstructionRegistry::Object {
+	using test::ConstructionRegistry::Object::Object;
+};
+
 template <size_t BYTES>
 struct BigObject : test::ConstructionRegistry::Object {
 	char _[BYTES - sizeof(test::ConstructionRegistry::Object)];
@@ -71,41 +189,115 @@ struct BigObject : test::ConstructionRegistry::Object {
 
 using StorageScenarioSBOFitting = StorageScenario<SBOStorage<sizeof(SmallObject)>, SmallObject>;
 using StorageScenarioSBONonFitting = StorageScenario<SBOStorage<sizeof(SmallObject)>, BigObject<128>>;
+using StorageScenarioPooledSBONonFitting = StorageScenario<
+	SBOStorage<sizeof(SmallObject), static_cast<std::size_t>(-1), PoolAllocator<>>,
+	BigObject<128>
+	>;
+using StorageScenarioCompactSBOFitting = StorageScenario<CompactSBOStorage<sizeof(SmallObject)>, SmallObject>;
+using StorageScenarioCompactSBONonFitting = StorageScenario<
+	CompactSBOStorage<sizeof(SmallObject)>,
+	BigObject<128>
+	>;
+using StorageScenarioAlignedSBOFitting = StorageScenario<
+	AlignedSBOStorage<sizeof(OverAlignedObject), alignof(OverAlignedObject)>,
+	OverAlignedObject
+	>;
+using StorageScenarioAlignedSBONonFitting = StorageScenario<
+	AlignedSBOStorage<sizeof(SmallObject)>,
+	BigObject<128>
+	>;
+using StorageScenarioPmrSBOFitting = StorageScenario<PmrSBOStorage<sizeof(SmallObject)>, SmallObject>;
+using StorageScenarioPmrSBONonFitting = StorageScenario<PmrSBOStorage<sizeof(SmallObject)>, BigObject<128>>;
 using StorageScenarioRemote = StorageScenario<RemoteStorage<>, SmallObject>;
+using StorageScenarioPmrRemote = StorageScenario<PmrRemoteStorage, SmallObject>;
+using StorageScenarioPooledRemote = StorageScenario<RemoteStorage<PoolAllocator<>>, SmallObject>;
 using StorageScenarioSharedRemote = StorageScenario<SharedRemoteStorage<>, SmallObject>;
+using StorageScenarioPooledSharedRemote = StorageScenario<SharedRemoteStorage<PoolAllocator<>>, SmallObject>;
+using StorageScenarioIntrusiveSharedRemote = StorageScenario<IntrusiveSharedRemoteStorage<>, SmallObject>;
+using StorageScenarioNonAtomicIntrusiveSharedRemote = StorageScenario<
+	IntrusiveSharedRemoteStorage<NonAtomicRefCount>,
+	SmallObject
+	>;
+using StorageScenarioCow = StorageScenario<CowStorage<>, SmallObject>;
 using StorageScenarioLocal = StorageScenario<LocalStorage<sizeof(SmallObject)>, SmallObject>;
+using StorageScenarioAlignedLocal = StorageScenario<
+	AlignedLocalStorage<sizeof(OverAlignedObject), alignof(OverAlignedObject)>,
+	OverAlignedObject
+	>;
 using StorageScenarioNonOwning = StorageScenario<NonOwningStorage, SmallObject>;
 
 using AllStorageTestTypes = ::testing::Types<
 	StorageScenarioSBOFitting,
 	StorageScenarioSBONonFitting,
+	StorageScenarioPooledSBONonFitting,
+	StorageScenarioCompactSBOFitting,
+	StorageScenarioCompactSBONonFitting,
+	StorageScenarioAlignedSBOFitting,
+	StorageScenarioAlignedSBONonFitting,
+	StorageScenarioPmrSBOFitting,
+	StorageScenarioPmrSBONonFitting,
 	StorageScenarioRemote,
+	StorageScenarioPooledRemote,
+	StorageScenarioPmrRemote,
 	StorageScenarioSharedRemote,
+	StorageScenarioPooledSharedRemote,
+	StorageScenarioIntrusiveSharedRemote,
+	StorageScenarioNonAtomicIntrusiveSharedRemote,
+	StorageScenarioCow,
 	StorageScenarioLocal,
+	StorageScenarioAlignedLocal,
 	StorageScenarioNonOwning
 	>;
 TYPED_TEST_CASE(AllStorageTest, AllStorageTestTypes);
 
 using RemoteStorageTestTypes = ::testing::Types<
 	StorageScenarioSBONonFitting,
+	StorageScenarioPooledSBONonFitting,
+	StorageScenarioCompactSBONonFitting,
+	StorageScenarioAlignedSBONonFitting,
+	StorageScenarioPmrSBONonFitting,
 	StorageScenarioRemote,
+	StorageScenarioPooledRemote,
+	StorageScenarioPmrRemote,
 	StorageScenarioSharedRemote,
+	StorageScenarioPooledSharedRemote,
+	StorageScenarioIntrusiveSharedRemote,
+	StorageScenarioNonAtomicIntrusiveSharedRemote,
+	StorageScenarioCow,
 	StorageScenarioNonOwning
 	>;
 TYPED_TEST_CASE(RemoteStorageTest, RemoteStorageTestTypes);
 
 using LocalStorageTestTypes = ::testing::Types<
 	StorageScenarioSBOFitting,
-	StorageScenarioLocal
+	StorageScenarioCompactSBOFitting,
+	StorageScenarioAlignedSBOFitting,
+	StorageScenarioPmrSBOFitting,
+	StorageScenarioLocal,
+	StorageScenarioAlignedLocal
 	>;
 TYPED_TEST_CASE(LocalStorageTest, LocalStorageTestTypes);
 
 using OwningStorageTestTypes = ::testing::Types<
 	StorageScenarioSBOFitting,
 	StorageScenarioSBONonFitting,
+	StorageScenarioPooledSBONonFitting,
+	StorageScenarioCompactSBOFitting,
+	StorageScenarioCompactSBONonFitting,
+	StorageScenarioAlignedSBOFitting,
+	StorageScenarioAlignedSBONonFitting,
+	StorageScenarioPmrSBOFitting,
+	StorageScenarioPmrSBONonFitting,
 	StorageScenarioRemote,
+	StorageScenarioPooledRemote,
+	StorageScenarioPmrRemote,
 	StorageScenarioSharedRemote,
-	StorageScenarioLocal
+	StorageScenarioPooledSharedRemote,
+	StorageScenarioIntrusiveSharedRemote,
+	StorageScenarioNonAtomicIntrusiveSharedRemote,
+	StorageScenarioCow,
+	StorageScenarioLocal,
+	StorageScenarioAlignedLocal
 >;
 TYPED_TEST_CASE(OwningStorageTest, OwningStorageTestTypes);
 
@@ -127,7 +319,7 @@ TYPED_TEST(AllStorageTest, HasStorageInfoForObject) {
 	using VTable = VTable<Local<Everything>>;
 	auto vtable = VTable::Type<ObjectInterface>{complete};
 
-	const auto storageInfo = vtable[STORAGE_INFO_LABEL]();
+	const auto storageInfo = vtable[STORAGE_INFO_LABEL];
 
 	EXPECT_EQ(storageInfo.size, sizeof(Object));
 	EXPECT_EQ(storageInfo.alignment, alignof(Object));
@@ -170,7 +362,7 @@ TYPED_TEST(LocalStorageTest, MovesStoredObject) {
 
 	auto m = Storage(std::move(s), vtable);
 
-	const auto& state = m.template get<Object>()->state();
+	const auto& state = objectIn<Object>(m, vtable)->state();
 	EXPECT_TRUE(state.moveConstructed);
 	EXPECT_EQ(state.original, &original);
 }
@@ -183,19 +375,20 @@ TYPED_TEST(RemoteStorageTest, MovesPointerToStoredObject) {
 
 	auto original = Object(registry);
 	Storage s{original};
-	auto* storedData = s.template get<Object>();
 
 	const auto complete = completeConceptMap<ObjectInterface, Object>(
 		conceptMap<ObjectInterface, Object>);
 	using VTable = VTable<Local<Everything>>;
 	auto vtable = VTable::Type<ObjectInterface>{complete};
 
+	auto* storedData = objectIn<Object>(s, vtable);
+
 	auto m = Storage(std::move(s), vtable);
 
 	if constexpr (!std::is_same_v<Storage, NonOwningStorage>) {
-		EXPECT_EQ(s.template get<Object>(), static_cast<Object*>(nullptr));
+		EXPECT_EQ(objectIn<Object>(s, vtable), static_cast<Object*>(nullptr));
 	}
-	EXPECT_EQ(m.template get<Object>(), storedData);
+	EXPECT_EQ(objectIn<Object>(m, vtable), storedData);
 }
 
 TYPED_TEST(OwningStorageTest, CopiesStoredObject) {
@@ -214,7 +407,7 @@ TYPED_TEST(OwningStorageTest, CopiesStoredObject) {
 
 	auto c = Storage(s, vtable);
 
-	const auto& state = c.template get<Object>()->state();
+	const auto& state = objectIn<Object>(c, vtable)->state();
 	EXPECT_TRUE(state.copyConstructed);
 	EXPECT_EQ(state.original, &original);
 }
@@ -240,4 +433,473 @@ TYPED_TEST(NonOwningStorageTest, CopiesPointerToStoredObject) {
 	EXPECT_EQ(c.template get<Object>(), storedData);
 }
 
+TEST(ArenaStorageTest, StoresDataInArena) {
+	auto arena = Arena();
+	auto* expected = static_cast<char*>(arena.allocate(0, alignof(S<2>)));
+
+	auto storage = ArenaStorage(std::allocator_arg, arena, S<2>{});
+
+	EXPECT_EQ(reinterpret_cast<char*>(storage.template get<S<2>>()), expected);
+	EXPECT_EQ(storage.arena(), &arena);
+}
+
+TEST(ArenaStorageTest, CopiesIntoSourceArena) {
+	auto registry = test::ConstructionRegistry();
+	auto arena = Arena();
+
+	auto original = SmallObject(registry);
+	auto s = ArenaStorage(std::allocator_arg, arena, original);
+
+	const auto complete = completeConceptMap<ObjectInterface, SmallObject>(
+		conceptMap<ObjectInterface, SmallObject>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	auto c = ArenaStorage(s, vtable);
+
+	EXPECT_EQ(c.arena(), &arena);
+	EXPECT_NE(c.template get<SmallObject>(), s.template get<SmallObject>());
+	const auto& state = c.template get<SmallObject>()->state();
+	EXPECT_TRUE(state.copyConstructed);
+	EXPECT_EQ(state.original, &original);
+
+	c.destruct(vtable);
+	s.destruct(vtable);
+}
+
+TEST(ArenaStorageTest, MovesPointerToStoredObject) {
+	auto registry = test::ConstructionRegistry();
+	auto arena = Arena();
+
+	auto original = SmallObject(registry);
+	auto s = ArenaStorage(std::allocator_arg, arena, original);
+	auto* storedData = s.template get<SmallObject>();
+
+	const auto complete = completeConceptMap<ObjectInterface, SmallObject>(
+		conceptMap<ObjectInterface, SmallObject>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	auto m = ArenaStorage(std::move(s), vtable);
+
+	EXPECT_EQ(s.template get<SmallObject>(), static_cast<SmallObject*>(nullptr));
+	EXPECT_EQ(m.template get<SmallObject>(), storedData);
+
+	s.destruct(vtable);
+	m.destruct(vtable);
+}
+
+TEST(ArenaStorageTest, DestroysStoredObject) {
+	auto registry = test::ConstructionRegistry();
+	auto arena = Arena();
+
+	{
+		auto original = SmallObject(registry);
+		auto s = ArenaStorage(std::allocator_arg, arena, original);
+
+		const auto complete = completeConceptMap<ObjectInterface, SmallObject>(
+			conceptMap<ObjectInterface, SmallObject>);
+		using VTable = VTable<Local<Everything>>;
+		auto vtable = VTable::Type<ObjectInterface>{complete};
+
+		s.destruct(vtable);
+	}
+
+	EXPECT_TRUE(registry.allDestructed());
+}
+
+class CountingResource : public std::pmr::memory_resource {
+public:
+
+	int allocations = 0;
+
+	int deallocations = 0;
+
+private:
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		++allocations;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+		++deallocations;
+		std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+};
+
+TEST(PmrStorageTest, AllocatesFromGivenResource) {
+	auto resource = CountingResource();
+
+	auto remote = PmrRemoteStorage(std::allocator_arg, &resource, S<1>{});
+	auto sbo = PmrSBOStorage<sizeof(void*)>(std::allocator_arg, &resource, S<2>{});
+	auto inlineSbo = PmrSBOStorage<sizeof(void*)>(std::allocator_arg, &resource, S<1>{});
+
+	EXPECT_EQ(remote.resource(), &resource);
+	EXPECT_EQ(sbo.resource(), &resource);
+	EXPECT_EQ(inlineSbo.resource(), &resource);
+	EXPECT_EQ(resource.allocations, 2);
+}
+
+TEST(PmrStorageTest, UsesDefaultResourceWhenNoneGiven) {
+	auto remote = PmrRemoteStorage(S<1>{});
+	EXPECT_EQ(remote.resource(), std::pmr::get_default_resource());
+}
+
+template <class Storage>
+void checkResourcePropagation() {
+	auto registry = test::ConstructionRegistry();
+	auto first = CountingResource();
+	auto second = CountingResource();
+
+	const auto complete = completeConceptMap<ObjectInterface, BigObject<128>>(
+		conceptMap<ObjectInterface, BigObject<128>>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	{
+		auto original = BigObject<128>(registry);
+		auto a = Storage(std::allocator_arg, &first, original);
+		auto b = Storage(std::allocator_arg, &second, original);
+
+		auto copy = Storage(a, vtable);
+		EXPECT_EQ(copy.resource(), &first);
+		EXPECT_EQ(first.allocations, 2);
+
+		auto moved = Storage(std::move(copy), vtable);
+		EXPECT_EQ(moved.resource(), &first);
+		EXPECT_EQ(first.allocations, 2);
+
+		a.swap(vtable, b, vtable);
+		EXPECT_EQ(a.resource(), &second);
+		EXPECT_EQ(b.resource(), &first);
+
+		a.destruct(vtable);
+		b.destruct(vtable);
+		copy.destruct(vtable);
+		moved.destruct(vtable);
+	}
+
+	EXPECT_EQ(first.deallocations, first.allocations);
+	EXPECT_EQ(second.deallocations, second.allocations);
+	EXPECT_TRUE(registry.allDestructed());
+}
+
+TEST(PmrStorageTest, PropagatesResourceInRemoteStorage) {
+	checkResourcePropagation<PmrRemoteStorage>();
+}
+
+TEST(PmrStorageTest, PropagatesResourceInSBOStorage) {
+	checkResourcePropagation<PmrSBOStorage<sizeof(SmallObject)>>();
+}
+
+TEST(PmrStorageTest, SwapsInlineAndHeapObjects) {
+	auto registry = test::ConstructionRegistry();
+	auto first = CountingResource();
+	auto second = CountingResource();
+
+	using Storage = PmrSBOStorage<sizeof(SmallObject)>;
+	using VTable = VTable<Local<Everything>>;
+	auto smallVTable = VTable::Type<ObjectInterface>{
+		completeConceptMap<ObjectInterface, SmallObject>(conceptMap<ObjectInterface, SmallObject>)
+		};
+	auto bigVTable = VTable::Type<ObjectInterface>{
+		completeConceptMap<ObjectInterface, BigObject<128>>(conceptMap<ObjectInterface, BigObject<128>>)
+		};
+
+	{
+		auto small = Storage(std::allocator_arg, &first, SmallObject(registry));
+		auto big = Storage(std::allocator_arg, &second, BigObject<128>(registry));
+		auto* bigData = big.template get<BigObject<128>>();
+
+		small.swap(smallVTable, big, bigVTable);
+		EXPECT_EQ(small.template get<BigObject<128>>(), bigData);
+		EXPECT_EQ(small.resource(), &second);
+		EXPECT_EQ(big.resource(), &first);
+
+		small.destruct(bigVTable);
+		big.destruct(smallVTable);
+	}
+
+	EXPECT_EQ(first.allocations, 0);
+	EXPECT_EQ(second.deallocations, 1);
+	EXPECT_TRUE(registry.allDestructed());
+}
+
+struct CountingAllocator {
+	static inline int allocations = 0;
+
+	static void* allocate(std::size_t size) {
+		++allocations;
+		return MallocAllocator::allocate(size);
+	}
+
+	static void free(void* ptr) {
+		--allocations;
+		MallocAllocator::free(ptr);
+	}
+};
+
+template <class RefCount>
+void checkIntrusiveSharing() {
+	auto registry = test::ConstructionRegistry();
+
+	using Storage = IntrusiveSharedRemoteStorage<RefCount, CountingAllocator>;
+	const auto complete = completeConceptMap<ObjectInterface, SmallObject>(
+		conceptMap<ObjectInterface, SmallObject>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	{
+		auto s = Storage(SmallObject(registry));
+		EXPECT_EQ(CountingAllocator::allocations, 1);
+		EXPECT_EQ(s.useCount(), 1u);
+
+		auto c = Storage(s, vtable);
+		EXPECT_EQ(c.template get<SmallObject>(), s.template get<SmallObject>());
+		EXPECT_EQ(s.useCount(), 2u);
+		EXPECT_EQ(CountingAllocator::allocations, 1);
+
+		auto m = Storage(std::move(c), vtable);
+		EXPECT_EQ(c.useCount(), 0u);
+		EXPECT_EQ(m.useCount(), 2u);
+
+		s.destruct(vtable);
+		EXPECT_FALSE(m.template get<SmallObject>()->state().destructed);
+		EXPECT_EQ(m.useCount(), 1u);
+
+		c.destruct(vtable);
+		m.destruct(vtable);
+		EXPECT_EQ(CountingAllocator::allocations, 0);
+	}
+
+	EXPECT_TRUE(registry.allDestructed());
+}
+
+TEST(IntrusiveSharedRemoteStorageTest, SharesObjectWithAtomicCount) {
+	checkIntrusiveSharing<AtomicRefCount>();
+}
+
+TEST(IntrusiveSharedRemoteStorageTest, SharesObjectWithNonAtomicCount) {
+	checkIntrusiveSharing<NonAtomicRefCount>();
+}
+
+struct ThrowingCopy {
+	void* p[4];
+
+	ThrowingCopy() = default;
+
+	ThrowingCopy(ThrowingCopy&&) = default;
+
+	ThrowingCopy(const ThrowingCopy&) {
+		throw std::runtime_error("copy");
+	}
+};
+
+// Copying the registered member and then throwing leaves an object that must be
+// destroyed even though its owner never finished construction.
+struct ThrowingRegisteredCopy {
+	test::ConstructionRegistry::Object object;
+
+	explicit ThrowingRegisteredCopy(test::ConstructionRegistry& registry) :
+		object(registry)
+	{
+	}
+
+	ThrowingRegisteredCopy(ThrowingRegisteredCopy&&) = default;
+
+	ThrowingRegisteredCopy(const ThrowingRegisteredCopy& other) :
+		object(other.object)
+	{
+		throw std::runtime_error("copy");
+	}
+};
+
+TEST(IntrusiveSharedRemoteStorageTest, FreesMemoryWhenConstructionThrows) {
+	auto registry = test::ConstructionRegistry();
+
+	using Storage = IntrusiveSharedRemoteStorage<NonAtomicRefCount, CountingAllocator>;
+
+	{
+		const auto object = ThrowingRegisteredCopy(registry);
+		EXPECT_THROW(Storage{ object }, std::runtime_error);
+		EXPECT_EQ(CountingAllocator::allocations, 0);
+	}
+
+	EXPECT_TRUE(registry.allDestructed());
+}
+
+template <class Storage>
+void checkHeapConstructionExceptionSafety() {
+	const auto complete = completeConceptMap<ObjectInterface, ThrowingCopy>(
+		conceptMap<ObjectInterface, ThrowingCopy>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	const auto object = ThrowingCopy();
+	EXPECT_THROW(Storage{ object }, std::runtime_error);
+	EXPECT_EQ(CountingAllocator::allocations, 0);
+
+	auto s = Storage(ThrowingCopy());
+	EXPECT_EQ(CountingAllocator::allocations, 1);
+	EXPECT_THROW((Storage{ s, vtable }), std::runtime_error);
+	EXPECT_EQ(CountingAllocator::allocations, 1);
+
+	s.destruct(vtable);
+	EXPECT_EQ(CountingAllocator::allocations, 0);
+}
+
+TEST(SBOStorageTest, FreesMemoryWhenHeapConstructionThrows) {
+	checkHeapConstructionExceptionSafety<SBOStorage<sizeof(void*), static_cast<std::size_t>(-1), CountingAllocator>>();
+	checkHeapConstructionExceptionSafety<CompactSBOStorage<2 * sizeof(void*), alignof(void*), CountingAllocator>>();
+	checkHeapConstructionExceptionSafety<AlignedSBOStorage<sizeof(void*), 32, CountingAllocator>>();
+	checkHeapConstructionExceptionSafety<RemoteStorage<CountingAllocator>>();
+}
+
+template <class Storage>
+void checkResourceHeapConstructionExceptionSafety() {
+	auto resource = CountingResource();
+	const auto complete = completeConceptMap<ObjectInterface, ThrowingCopy>(
+		conceptMap<ObjectInterface, ThrowingCopy>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	const auto object = ThrowingCopy();
+	EXPECT_THROW(Storage(std::allocator_arg, &resource, object), std::runtime_error);
+	EXPECT_EQ(resource.deallocations, resource.allocations);
+
+	auto s = Storage(std::allocator_arg, &resource, ThrowingCopy());
+	EXPECT_THROW((Storage{ s, vtable }), std::runtime_error);
+	EXPECT_EQ(resource.deallocations + 1, resource.allocations);
+
+	s.destruct(vtable);
+	EXPECT_EQ(resource.deallocations, resource.allocations);
+}
+
+TEST(PmrStorageTest, FreesMemoryWhenHeapConstructionThrows) {
+	checkResourceHeapConstructionExceptionSafety<PmrRemoteStorage>();
+	checkResourceHeapConstructionExceptionSafety<PmrSBOStorage<sizeof(void*)>>();
+}
+
+TEST(CowStorageTest, UnsharesOnMutableAccess) {
+	auto registry = test::ConstructionRegistry();
+
+	using Storage = CowStorage<NonAtomicRefCount, CountingAllocator>;
+	const auto complete = completeConceptMap<ObjectInterface, SmallObject>(
+		conceptMap<ObjectInterface, SmallObject>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	{
+		auto original = SmallObject(registry);
+		auto s = Storage(original);
+		auto c = Storage(s, vtable);
+		EXPECT_EQ(c.useCount(), 2u);
+		EXPECT_EQ(CountingAllocator::allocations, 1);
+
+		auto* shared = s.template get<SmallObject>();
+		auto* unshared = c.template get<SmallObject>(vtable);
+		EXPECT_NE(unshared, shared);
+		EXPECT_TRUE(unshared->state().copyConstructed);
+		EXPECT_EQ(CountingAllocator::allocations, 2);
+		EXPECT_EQ(s.useCount(), 1u);
+		EXPECT_EQ(c.useCount(), 1u);
+
+		// Sole owners don't copy anything.
+		EXPECT_EQ(s.template get<SmallObject>(vtable), shared);
+		EXPECT_EQ(CountingAllocator::allocations, 2);
+
+		s.destruct(vtable);
+		c.destruct(vtable);
+		EXPECT_EQ(CountingAllocator::allocations, 0);
+	}
+
+	EXPECT_TRUE(registry.allDestructed());
+}
+
+TEST(CowStorageTest, FreesMemoryWhenCopyingThrows) {
+	auto registry = test::ConstructionRegistry();
+
+	using Storage = CowStorage<NonAtomicRefCount, CountingAllocator>;
+	const auto complete = completeConceptMap<ObjectInterface, ThrowingRegisteredCopy>(
+		conceptMap<ObjectInterface, ThrowingRegisteredCopy>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	{
+		const auto object = ThrowingRegisteredCopy(registry);
+		EXPECT_THROW(Storage{ object }, std::runtime_error);
+		EXPECT_EQ(CountingAllocator::allocations, 0);
+
+		auto s = Storage(ThrowingRegisteredCopy(registry));
+		auto c = Storage(s, vtable);
+		auto* shared = s.template get<ThrowingRegisteredCopy>();
+
+		// A failed unshare leaves both storages sharing the original object.
+		EXPECT_THROW(c.template get<ThrowingRegisteredCopy>(vtable), std::runtime_error);
+		EXPECT_EQ(CountingAllocator::allocations, 1);
+		EXPECT_EQ(c.template get<ThrowingRegisteredCopy>(), shared);
+		EXPECT_EQ(s.useCount(), 2u);
+
+		s.destruct(vtable);
+		c.destruct(vtable);
+		EXPECT_EQ(CountingAllocator::allocations, 0);
+	}
+
+	EXPECT_TRUE(registry.allDestructed());
+}
+
+TEST(SBOStorageTest, RelocatesInlineObjectsOnMove) {
+	auto registry = test::ConstructionRegistry();
+
+	using Storage = SBOStorage<sizeof(SmallObject)>;
+	const auto complete = completeConceptMap<ObjectInterface, SmallObject>(
+		conceptMap<ObjectInterface, SmallObject>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	auto s = Storage(SmallObject(registry));
+	auto* source = s.template get<SmallObject>();
+
+	auto m = Storage(std::move(s), vtable);
+
+	EXPECT_TRUE(m.template get<SmallObject>()->state().moveConstructed);
+	EXPECT_TRUE(registry.get(source).destructed);
+	EXPECT_EQ(s.template get<SmallObject>(), static_cast<SmallObject*>(nullptr));
+
+	s.destruct(vtable);
+	m.destruct(vtable);
+
+	EXPECT_TRUE(registry.allDestructed());
+}
+
+TEST(SBOStorageTest, SwapsTriviallyCopyableObjectsBytewise) {
+	using Storage = SBOStorage<sizeof(S<1>)>;
+	const auto complete = completeConceptMap<ObjectInterface, S<1>>(
+		conceptMap<ObjectInterface, S<1>>);
+	using VTable = VTable<Local<Everything>>;
+	auto vtable = VTable::Type<ObjectInterface>{complete};
+
+	auto first = 1;
+	auto second = 2;
+	auto a = Storage(S<1>{ { &first } });
+	auto b = Storage(S<1>{ { &second } });
+
+	a.swap(vtable, b, vtable);
+	EXPECT_EQ(a.template get<S<1>>()->p[0], &second);
+	EXPECT_EQ(b.template get<S<1>>()->p[0], &first);
+
+	auto m = Storage(std::move(a), vtable);
+	EXPECT_EQ(m.template get<S<1>>()->p[0], &second);
+
+	a.destruct(vtable);
+	b.destruct(vtable);
+	m.destruct(vtable);
+}
+
 } // anonymous namespace
@@ -3,7 +3,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 #include "caramel-poly/vtable.hpp"
 
@@ -14,6 +17,7 @@ using namespace caramel::poly;
 const auto fooName = POLY_FUNCTION_LABEL("foo");
 const auto barName = POLY_FUNCTION_LABEL("bar");
 const auto bazName = POLY_FUNCTION_LABEL("baz");
+const auto sizeName = POLY_FUNCTION_LABEL("size");
 
 struct Parent : decltype(requires(
 	fooName = method<int () const>
@@ -29,25 +33,102 @@ struct Interface : decltype(requires(
 {
 };
 
+struct HotInterface : decltype(requires(
+	fooName = hot(method<int () const>),
+	barName = method<int (int) const>,
+	bazName = method<void (double)>
+	))
+{
+};
+
+struct BazProfile {
+	static constexpr const char* HOT_FUNCTIONS[] = { "baz" };
+};
+
 struct S {
 	int i;
 };
 
+struct Numbered : decltype(requires(
+	fooName = method<int () const>
+	))
+{
+};
+
+template <int N>
+struct Number {
+};
+
+struct Sized : decltype(requires(
+	sizeName = constant<std::size_t>
+	))
+{
+};
+
+struct SizedNumbered : decltype(requires(
+	Sized{},
+	Numbered{}
+	))
+{
+};
+
+template <class T>
+struct SizeOf {
+	constexpr std::size_t operator()() const {
+		return sizeof(T);
+	}
+};
+
 } // anonymous namespace
 
+template <class T>
+const auto caramel::poly::defaultConceptMap<Sized, T> = makeConceptMap(
+	POLY_FUNCTION_LABEL("size") = SizeOf<T>{}
+	);
+
+template <class T>
+const auto caramel::poly::defaultConceptMap<Numbered, T> = makeConceptMap(
+	POLY_FUNCTION_LABEL("foo") = [](const T&) { return 0; }
+	);
+
 template <class T>
 const auto caramel::poly::defaultConceptMap<Interface, T> = makeConceptMap(
 	POLY_FUNCTION_LABEL("foo") = [](const S& s) { return s.i; },
 	POLY_FUNCTION_LABEL("bar") = [](const S& s, int i) { return s.i * i; }
 	);
 
+template <>
+const auto caramel::poly::conceptMap<HotInterface, S> = makeConceptMap(
+	POLY_FUNCTION_LABEL("foo") = [](const S& s) { return s.i; },
+	POLY_FUNCTION_LABEL("bar") = [](const S& s, int i) { return s.i * i; },
+	POLY_FUNCTION_LABEL("baz") = [](S& s, double d) { s.i = static_cast<int>(d); }
+	);
+
 template <class T>
 const auto caramel::poly::conceptMap<Interface, T, std::enable_if_t<std::is_same_v<T, S>>> = makeConceptMap(
 	POLY_FUNCTION_LABEL("baz") = [](S& s, double d) { s.i = static_cast<int>(d); }
 	);
 
+template <>
+const auto caramel::poly::conceptMap<Sized, S> = makeConceptMap(
+	POLY_FUNCTION_LABEL("size") = []() { return std::size_t(42); }
+	);
+
 namespace /* anonymous */ {
 
+using SizedTable = LocalVTable<
+	detail::ConstexprPair<std::decay_t<decltype(sizeName)>, decltype(Sized{}.getSignature(sizeName))>
+	>;
+
+using SizedRemote = RemoteVTable<SizedTable, Sized>;
+
+template <class T>
+using SizedMap = decltype(completeConceptMap<Sized, T>(conceptMap<Sized, T>));
+
+// Read during the dynamic initialization of the test, in no particular order
+// with the tables that can't be constant initialized.
+const auto EARLY_SIZE = SizedRemote{ SizedMap<S>{} }[sizeName];
+
 TEST(VTableTest, LocalVTableStoredFunctionsAreAccessible) {
 	auto s = S{ 3 };
 
@@ -91,6 +172,109 @@ TEST(VTableTest, RemoteVTableStoredFunctionsAreAccessible) {
 	// vtable[bzzName];
 }
 
+TEST(VTableTest, IndexedVTableStoredFunctionsAreAccessible) {
+	auto s = S{ 3 };
+
+	const auto complete = completeConceptMap<Interface, S>(conceptMap<Interface, S>);
+	using Local = LocalVTable<
+		detail::ConstexprPair<std::decay_t<decltype(fooName)>, decltype(Interface{}.getSignature(fooName))>,
+		detail::ConstexprPair<std::decay_t<decltype(barName)>, decltype(Interface{}.getSignature(barName))>,
+		detail::ConstexprPair<std::decay_t<decltype(bazName)>, decltype(Interface{}.getSignature(bazName))>
+		>;
+	const auto vtable = IndexedVTable<Local, std::uint16_t>{ complete };
+
+	static_assert(sizeof(vtable) == sizeof(std::uint16_t));
+
+	EXPECT_TRUE(vtable.contains(fooName));
+	EXPECT_EQ((*vtable[fooName])(&s), 3);
+	EXPECT_EQ((*vtable[barName])(&s, 2), 6);
+	(*vtable[bazName])(&s, 42.12);
+	EXPECT_EQ(s.i, 42);
+
+	const auto other = IndexedVTable<Local, std::uint16_t>{ complete };
+	EXPECT_EQ(other.index(), vtable.index());
+	EXPECT_EQ((IndexedVTable<Local, std::uint16_t>::indexOf(complete)), vtable.index());
+	EXPECT_EQ(other.sharedTable(fooName), vtable.sharedTable(fooName));
+}
+
+template <int... N>
+int countIndexOverflows(std::integer_sequence<int, N...>) {
+	using Local = LocalVTable<
+		detail::ConstexprPair<std::decay_t<decltype(fooName)>, decltype(Numbered{}.getSignature(fooName))>
+		>;
+	auto overflows = 0;
+	const auto index = [&overflows](auto map) {
+		try {
+			IndexedVTable<Local, std::uint8_t>::indexOf(map);
+		} catch (const std::length_error&) {
+			++overflows;
+		}
+	};
+	(index(completeConceptMap<Numbered, Number<N>>(conceptMap<Numbered, Number<N>>)), ...);
+	return overflows;
+}
+
+TEST(VTableTest, IndexedVTableThrowsWhenTheIndexOverflows) {
+	EXPECT_EQ(countIndexOverflows(std::make_integer_sequence<int, 258>()), 2);
+}
+
+TEST(VTableTest, SlicesSharedTablesOfRefinedConcepts) {
+	using SizedConcept = decltype(requires(Sized{}));
+	using SizedNumberedConcept = decltype(requires(SizedNumbered{}));
+	using SizedTable = LocalVTable<
+		detail::ConstexprPair<std::decay_t<decltype(sizeName)>, decltype(Sized{}.getSignature(sizeName))>
+		>;
+	using SizedNumberedTable = LocalVTable<
+		detail::ConstexprPair<std::decay_t<decltype(fooName)>, decltype(SizedNumbered{}.getSignature(fooName))>,
+		detail::ConstexprPair<std::decay_t<decltype(sizeName)>, decltype(SizedNumbered{}.getSignature(sizeName))>
+		>;
+	using Indexed = IndexedVTable<SizedTable, std::uint32_t, SizedConcept>;
+	using Remote = RemoteVTable<SizedTable, SizedConcept>;
+	using Source = RemoteVTable<SizedNumberedTable, SizedNumberedConcept>;
+
+	static_assert(Source::hasSlice<Remote::Table>());
+	static_assert(!Remote::hasSlice<Source::Table>());
+	static_assert(!std::is_constructible_v<Remote, detail::SliceTag, const RemoteVTable<SizedTable>&>);
+
+	// The tables of empty types hold the same size.
+	const auto firstIndex = Indexed::indexOf(completeConceptMap<SizedConcept, Number<-1>>(conceptMap<SizedConcept, Number<-1>>));
+	const auto secondIndex = Indexed::indexOf(completeConceptMap<SizedConcept, Number<-2>>(conceptMap<SizedConcept, Number<-2>>));
+	EXPECT_NE(firstIndex, secondIndex);
+
+	const auto source = Source{
+		completeConceptMap<SizedNumberedConcept, Number<-2>>(conceptMap<SizedNumberedConcept, Number<-2>>) };
+	const auto sliced = Indexed{ detail::SliceTag{}, source };
+	EXPECT_EQ(sliced.index(), secondIndex);
+	EXPECT_EQ(sliced[sizeName], source[sizeName]);
+
+	// The sliced table is the one built for the type directly.
+	const auto remote = Remote{ detail::SliceTag{}, source };
+	EXPECT_EQ(remote.sharedTable(sizeName), sliced.sharedTable(sizeName));
+	EXPECT_EQ(
+		remote.sharedTable(sizeName),
+		(Remote{ completeConceptMap<SizedConcept, Number<-2>>(conceptMap<SizedConcept, Number<-2>>) }.sharedTable(sizeName))
+		);
+
+	// Tables sliced before one is built from the concept map of the type share
+	// its index all the same.
+	const auto third = Indexed{ detail::SliceTag{}, Source{
+		completeConceptMap<SizedNumberedConcept, Number<-3>>(conceptMap<SizedNumberedConcept, Number<-3>>) } };
+	EXPECT_NE(third.index(), firstIndex);
+	EXPECT_EQ(
+		third.index(),
+		Indexed::indexOf(completeConceptMap<SizedConcept, Number<-3>>(conceptMap<SizedConcept, Number<-3>>))
+		);
+}
+
+TEST(VTableTest, BuildsTablesThatArentConstantWhenFirstNeeded) {
+	static_assert(detail::isConstantTable<SizedRemote::Table, SizedMap<Number<0>>>);
+	static_assert(!detail::isConstantTable<SizedRemote::Table, SizedMap<S>>);
+
+	EXPECT_EQ(EARLY_SIZE, 42u);
+	EXPECT_EQ((SizedRemote{ SizedMap<S>{} }[sizeName]), 42u);
+	EXPECT_EQ((SizedRemote{ SizedMap<Number<0>>{} }[sizeName]), sizeof(Number<0>));
+}
+
 TEST(VTableTest, JoinedVTableStoredFunctionsAreAccessible) {
 	auto s = S{ 3 };
 
@@ -211,4 +395,80 @@ TEST(VTableTest, SplitVTableGenerationTest) {
 	EXPECT_EQ(s.i, 5);
 }
 
+TEST(VTableTest, FlattensPoliciesOfTheSameKind) {
+	auto s = S{ 3 };
+
+	const auto complete = completeConceptMap<Interface, S>(conceptMap<Interface, S>);
+
+	using Generated = VTable<
+		Remote<Only<decltype(barName)>>,
+		Local<Only<decltype(fooName)>>,
+		Remote<Only<decltype(bazName)>>,
+		Local<EverythingElse>
+		>;
+	using Expected = JoinedVTable<
+		LocalVTable<
+			detail::ConstexprPair<std::decay_t<decltype(fooName)>, decltype(Interface{}.getSignature(fooName))>
+			>,
+		RemoteVTable<
+			LocalVTable<
+				detail::ConstexprPair<std::decay_t<decltype(barName)>, decltype(Interface{}.getSignature(barName))>,
+				detail::ConstexprPair<std::decay_t<decltype(bazName)>, decltype(Interface{}.getSignature(bazName))>
+				>,
+			Interface
+			>
+		>;
+	static_assert(std::is_same_v<Generated::Type<Interface>, Expected>);
+
+	const auto vtable = Generated::Type<Interface>{complete};
+	static_assert(sizeof(vtable) == 2 * sizeof(void*));
+
+	EXPECT_EQ((*vtable[fooName])(&s), 3);
+	EXPECT_EQ((*vtable[barName])(&s, 2), 6);
+	(*vtable[bazName])(&s, 5.5);
+	EXPECT_EQ(s.i, 5);
+}
+
+TEST(VTableTest, OnlyHotSelectsHotFunctions) {
+	using All = detail::ConstexprList<decltype(fooName), decltype(barName), decltype(bazName)>;
+
+	using Selected = decltype(OnlyHot<>{}(All{}, HotInterface{}));
+	static_assert(detail::isValidSelector<OnlyHot<>>);
+	static_assert(std::is_same_v<Selected::Second, detail::ConstexprList<std::decay_t<decltype(fooName)>>>);
+
+	using Profiled = decltype(OnlyHot<BazProfile>{}(All{}, HotInterface{}));
+	static_assert(
+		std::is_same_v<
+			Profiled::Second,
+			detail::ConstexprList<std::decay_t<decltype(fooName)>, std::decay_t<decltype(bazName)>>
+			>
+		);
+}
+
+TEST(VTableTest, AutoVTableGenerationTest) {
+	auto s = S{ 3 };
+
+	const auto complete = completeConceptMap<HotInterface, S>(conceptMap<HotInterface, S>);
+
+	const auto vtable = AutoVTable<>::Type<HotInterface>{complete};
+	static_assert(sizeof(vtable) == 2 * sizeof(void*));
+	static_assert(
+		std::is_same_v<
+			AutoVTable<>::Type<HotInterface>,
+			VTable<Local<Only<decltype(fooName)>>, Remote<EverythingElse>>::Type<HotInterface>
+			>
+		);
+
+	EXPECT_EQ((*vtable[fooName])(&s), 3);
+	EXPECT_EQ((*vtable[barName])(&s, 2), 6);
+	(*vtable[bazName])(&s, 5.5);
+	EXPECT_EQ(s.i, 5);
+
+	const auto profiled = AutoVTable<BazProfile>::Type<HotInterface>{complete};
+	static_assert(sizeof(profiled) == 3 * sizeof(void*));
+
+	(*profiled[bazName])(&s, 7.5);
+	EXPECT_EQ(s.i, 7);
+}
+
 } // anonymous namespace
@@ -8,6 +8,7 @@
 #include "caramel-poly/Poly.hpp"
 
 #include <typeinfo>
+#include <utility>
 
 // This test makes sure that we do not double-wrap `poly`s due to the implicit
 // constructors, despite the fact that the poly models the concept that it
@@ -22,6 +23,10 @@ struct Concept
 	: decltype(caramel::poly::requires(caramel::poly::CopyConstructible{}, caramel::poly::TypeId{}))
 { };
 
+struct Refined
+	: decltype(caramel::poly::requires(Concept{}, caramel::poly::MoveConstructible{}))
+{ };
+
 TEST(DynoTest, CtorImplicitDoubleWrap) {
   Foo foo;
   caramel::poly::Poly<Concept> poly{foo};
@@ -36,6 +41,15 @@ TEST(DynoTest, CtorImplicitDoubleWrap) {
 
   caramel::poly::Poly<Concept> implicit_copy = poly;
   EXPECT_EQ(implicit_copy.virtual_(caramel::poly::TYPEID_LABEL)(), typeid(Foo));
+
+  // The same goes for `poly`s of refined concepts.
+  caramel::poly::Poly<Refined> refined{foo};
+  caramel::poly::Poly<Concept> upcast = refined;
+  EXPECT_EQ(upcast.virtual_(caramel::poly::STORAGE_INFO_LABEL)().size, sizeof(Foo));
+  EXPECT_EQ(upcast.virtual_(caramel::poly::TYPEID_LABEL)(), typeid(Foo));
+
+  caramel::poly::Poly<Concept> moved = std::move(refined);
+  EXPECT_EQ(moved.virtual_(caramel::poly::TYPEID_LABEL)(), typeid(Foo));
 }
 
 } // anonymous namespace